@@ -0,0 +1,70 @@
+#include "accuracy.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace {
+std::atomic<bool> enabled{false};
+
+struct Registry {
+  std::mutex mutex;
+  std::map<std::string, Accuracy::Statistics> statistics;
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+thread_local Accuracy::Report last_report;
+}
+
+namespace Accuracy {
+void SetEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool IsEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Record(const char* operation, size_t size, double max_distance, double error_bound) {
+    last_report.operation = operation;
+    last_report.size = size;
+    last_report.max_distance = max_distance;
+    last_report.error_bound = error_bound;
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    Statistics& statistics = registry.statistics[operation];
+    statistics.operation = operation;
+    ++statistics.calls;
+    //fmax пропускает NaN, то есть операции без округления или без оценки
+    statistics.max_distance = std::fmax(statistics.max_distance, max_distance);
+    statistics.max_error_bound = std::fmax(statistics.max_error_bound, error_bound);
+    if (max_distance > kWarningDistance) {
+        ++statistics.warnings;
+    }
+}
+
+Report GetLastReport() {
+    return last_report;
+}
+
+std::vector<Statistics> GetStatistics() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<Statistics> result;
+    for (const auto& [operation, statistics] : registry.statistics) {
+        result.push_back(statistics);
+    }
+    return result;
+}
+
+void Reset() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.statistics.clear();
+}
+} // namespace Accuracy
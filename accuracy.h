@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Контроль точности: результаты ффт округляются до целых в Polynomial::operator==,
+// operator<< и в поиске подстрок, и это верно, пока погрешность меньше 0.5.
+// В режиме контроля (SetEnabled(true)) такие места сообщают, насколько далеко от
+// целых были округляемые значения, и априорную оценку погрешности вычисления.
+// Выключенный режим стоит одной проверки флага на вызов
+namespace Accuracy {
+// Вызовы, где значения отошли от целых дальше, считаются опасными
+const double kWarningDistance = 0.25;
+
+void SetEnabled(bool enabled);
+
+bool IsEnabled();
+
+struct Report {
+  std::string operation;
+  size_t size = 0;
+  // Наибольшее расстояние округляемых значений до ближайшего целого,
+  // NaN, если операция ничего не округляет
+  double max_distance = 0;
+  // Оценка сверху на погрешность значений, NaN, если оценки нет
+  double error_bound = 0;
+};
+
+struct Statistics {
+  std::string operation;
+  size_t calls = 0;
+  double max_distance = 0;
+  double max_error_bound = 0;
+  // Вызовы с max_distance > kWarningDistance
+  size_t warnings = 0;
+};
+
+// Добавляет отчет об одном вызове к статистике
+void Record(const char* operation, size_t size, double max_distance, double error_bound);
+
+// Последний отчет, записанный текущим потоком
+Report GetLastReport();
+
+// Статистика по всем операциям и потокам с последнего Reset
+std::vector<Statistics> GetStatistics();
+
+void Reset();
+
+template <typename Iterator>
+double MaxDistanceToInteger(Iterator begin, Iterator end) {
+    double result = 0;
+    for (; begin != end; ++begin) {
+        auto value = std::real(*begin);
+        result = std::max(result, static_cast<double>(std::abs(value - std::round(value))));
+    }
+    return result;
+}
+
+// Все ли значения - целые числа (с нулевой мнимой частью)
+template <typename T>
+bool IsIntegral(const std::vector<T>& values) {
+    for (const auto& value : values) {
+        if (std::real(value) != std::round(std::real(value)) || std::imag(value) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Оценка погрешности каждого коэффициента свертки first и second через ффт длины
+// transform_length: |c' - c| <= eps * log2(n) * ||first||_2 * ||second||_2 с запасом
+// по константе, eps - машинная точность типа коэффициентов. Множитель log2(n)
+// верен, пока каждый корень из 1 в преобразовании вычислен с ошибкой O(eps),
+// как в FFT::FastFourierTransform и FFT::Plan
+inline double ConvolutionErrorBound(double first_norm, double second_norm,
+                                    size_t transform_length, double epsilon) {
+    double levels = std::max(1.0, std::log2(double(transform_length)));
+    return 5 * epsilon * levels * first_norm * second_norm;
+}
+
+// То же с нормами, посчитанными по самим множителям
+template <typename T>
+double ConvolutionErrorBound(const std::vector<T>& first, const std::vector<T>& second,
+                             size_t transform_length) {
+    auto norm = [](const std::vector<T>& values) {
+        double sum = 0;
+        for (const auto& value : values) {
+            sum += static_cast<double>(std::norm(value));
+        }
+        return std::sqrt(sum);
+    };
+    return ConvolutionErrorBound(norm(first), norm(second), transform_length,
+                                 std::numeric_limits<typename T::value_type>::epsilon());
+}
+
+//Тесты
+void TestRecord();
+void TestErrorBound();
+void TestPolynomialAndMatching();
+} // namespace Accuracy
@@ -0,0 +1,155 @@
+#include "accuracy.h"
+#include "polynomial.h"
+#include "substring_matching.h"
+#include "test_runner.h"
+
+#include <random>
+
+namespace Accuracy {
+namespace {
+const Statistics* FindStatistics(const std::vector<Statistics>& statistics,
+                                 const std::string& operation) {
+    for (const auto& entry : statistics) {
+        if (entry.operation == operation) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+//Наибольшая ошибка коэффициентов произведения случайных многочленов, у
+//которых вместе length коэффициентов, против точной свертки в long double,
+//и оценка ConvolutionErrorBound для того же умножения
+template <typename T>
+std::pair<double, double> MeasureConvolutionError(size_t length, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(-1, 1);
+    std::vector<T> first(length / 2), second(length / 2);
+    for (auto& value : first) {
+        value = T(distribution(generator), distribution(generator));
+    }
+    for (auto& value : second) {
+        value = T(distribution(generator), distribution(generator));
+    }
+
+    std::vector<std::complex<long double>> exact(length - 1);
+    for (size_t i = 0; i < first.size(); ++i) {
+        for (size_t j = 0; j < second.size(); ++j) {
+            exact[i + j] += std::complex<long double>(first[i]) * std::complex<long double>(second[j]);
+        }
+    }
+
+    Polynomial<T> product(first);
+    product *= Polynomial<T>(second);
+    std::vector<T> coefficients = product.GetCoefficients();
+    double error = 0;
+    for (size_t i = 0; i < exact.size(); ++i) {
+        error = std::max(error, static_cast<double>(
+            std::abs(std::complex<long double>(coefficients[i]) - exact[i])));
+    }
+    return {error, ConvolutionErrorBound(first, second, length)};
+}
+}
+
+void TestRecord() {
+    Reset();
+
+    Record("test", 16, 0.01, 0.02);
+    Record("test", 32, 0.3, NAN);
+    Record("test", 8, NAN, 0.5);
+
+    Report report = GetLastReport();
+    ASSERT_EQUAL(report.operation, "test");
+    ASSERT_EQUAL(report.size, 8u);
+    ASSERT(std::isnan(report.max_distance));
+
+    std::vector<Statistics> statistics = GetStatistics();
+    const Statistics* test = FindStatistics(statistics, "test");
+    ASSERT(test != nullptr);
+    ASSERT_EQUAL(test->calls, 3u);
+    ASSERT_EQUAL(test->max_distance, 0.3);
+    ASSERT_EQUAL(test->max_error_bound, 0.5);
+    ASSERT_EQUAL(test->warnings, 1u);
+
+    std::vector<long double> real_values = {1.5, -2.125, 3};
+    ASSERT_EQUAL(MaxDistanceToInteger(begin(real_values), end(real_values)), 0.5);
+    std::vector<std::complex<double>> values = {{1.1, 5}, {-2.75, 0}, {3, 0}};
+    ASSERT(std::abs(MaxDistanceToInteger(begin(values), end(values)) - 0.25) < 1e-12);
+    ASSERT(!IsIntegral(values));
+    ASSERT(IsIntegral(std::vector<std::complex<double>>{{1, 0}, {-7, 0}}));
+
+    Reset();
+    ASSERT(GetStatistics().empty());
+}
+
+void TestErrorBound() {
+    using std::complex;
+
+    //при n >= 2^14 ошибка корней, накопленная степенями одного корня,
+    //уже выводила реальную погрешность за оценку
+    for (size_t length : {size_t(1) << 14, size_t(1) << 15}) {
+        for (unsigned seed = 1; seed <= 2; ++seed) {
+            auto [error, bound] = MeasureConvolutionError<complex<double>>(length, seed);
+            ASSERT(error <= bound);
+            std::tie(error, bound) = MeasureConvolutionError<complex<float>>(length, seed);
+            ASSERT(error <= bound);
+        }
+    }
+}
+
+void TestPolynomialAndMatching() {
+    using std::complex;
+
+    SetEnabled(true);
+    Reset();
+
+    //целые множители: расстояние до целых не больше оценки погрешности
+    std::vector<complex<double>> first(500), second(300);
+    for (size_t i = 0; i < first.size(); ++i) {
+        first[i] = double(i % 1000);
+    }
+    for (size_t i = 0; i < second.size(); ++i) {
+        second[i] = double(i % 7) - 3;
+    }
+    Polynomial<complex<double>> product(first);
+    product *= Polynomial<complex<double>>(second);
+    Report report = GetLastReport();
+    ASSERT_EQUAL(report.operation, "Polynomial::operator*=");
+    ASSERT_EQUAL(report.size, 1024u);
+    ASSERT(report.max_distance <= report.error_bound);
+    ASSERT(report.error_bound < 0.5);
+
+    //для float та же задача дает заметно большую оценку
+    std::vector<complex<float>> first_float(begin(first), end(first));
+    std::vector<complex<float>> second_float(begin(second), end(second));
+    Polynomial<complex<float>> product_float(first_float);
+    product_float *= Polynomial<complex<float>>(second_float);
+    ASSERT(GetLastReport().max_distance <= GetLastReport().error_bound);
+    ASSERT(GetLastReport().error_bound > report.error_bound * 1e6);
+
+    //нецелые множители ничего не округляют
+    Polynomial<complex<double>> fractional({0.5, 0.25});
+    fractional *= Polynomial<complex<double>>({0.5});
+    ASSERT(std::isnan(GetLastReport().max_distance));
+
+    ASSERT(product == product);
+    ASSERT_EQUAL(GetLastReport().operation, "Polynomial::operator==");
+
+    std::vector<size_t> matches = SubstringMatching::FindMatchesFFT("abracadabra", "a?ra");
+    ASSERT_EQUAL(matches, std::vector<size_t>({0, 7}));
+    report = GetLastReport();
+    ASSERT_EQUAL(report.operation, "SubstringMatching::FindMatchesFFT");
+    ASSERT(report.max_distance <= report.error_bound);
+
+    std::vector<Statistics> statistics = GetStatistics();
+    const Statistics* multiply = FindStatistics(statistics, "Polynomial::operator*=");
+    //три умножения выше и два внутри FindMatchesFFT
+    ASSERT(multiply != nullptr);
+    ASSERT_EQUAL(multiply->calls, 5u);
+    ASSERT_EQUAL(multiply->warnings, 0u);
+
+    SetEnabled(false);
+    Reset();
+    ASSERT(!IsEnabled());
+}
+} // namespace Accuracy
@@ -0,0 +1,224 @@
+#include "alphabet.h"
+#include "substring_matching.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+//байт некорректной последовательности UTF-8 становится символом 0xDC00 + байт:
+//одиночные суррогаты не бывают кодовыми точками корректного UTF-8
+const char32_t kEscapeBase = 0xDC00;
+
+//Разбирает text на кодовые точки, offsets[i] - смещение i-й точки в байтах
+void DecodeUtf8(std::string_view text, std::vector<char32_t>& symbols,
+                std::vector<size_t>* offsets) {
+    size_t i = 0;
+    while (i < text.size()) {
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3
+            : (lead >> 3) == 0x1E ? 4 : 0;
+        char32_t symbol = length == 1 ? lead : lead & (0x7F >> length);
+        bool valid = length != 0 && i + length <= text.size();
+        for (size_t j = 1; valid && j < length; ++j) {
+            unsigned char next = static_cast<unsigned char>(text[i + j]);
+            valid = (next >> 6) == 0x2;
+            symbol = (symbol << 6) | (next & 0x3F);
+        }
+        //избыточные записи, суррогаты и точки за 0x10FFFF некорректны
+        static const char32_t kMinSymbol[] = {0, 0, 0x80, 0x800, 0x10000};
+        valid = valid && symbol >= kMinSymbol[length] && symbol <= 0x10FFFF &&
+            (symbol < 0xD800 || symbol > 0xDFFF);
+        if (!valid) {
+            symbol = kEscapeBase + lead;
+            length = 1;
+        }
+        if (offsets != nullptr) {
+            offsets->push_back(i);
+        }
+        symbols.push_back(symbol);
+        i += length;
+    }
+}
+}
+
+namespace SubstringMatching {
+Alphabet::Alphabet(Unit unit, std::vector<char32_t> symbols)
+    : unit_(unit), symbols_(std::move(symbols)) {
+    if (unit_ == Unit::Byte) {
+        for (size_t i = 0; i < symbols_.size(); ++i) {
+            byte_codes_[symbols_[i]] = uint32_t(i + 1);
+        }
+    }
+}
+
+Alphabet Alphabet::Bytes() {
+    std::vector<char32_t> symbols(256);
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        symbols[i] = char32_t(i);
+    }
+    return Alphabet(Unit::Byte, std::move(symbols));
+}
+
+Alphabet Alphabet::FromText(std::string_view text, Unit unit) {
+    std::vector<char32_t> symbols;
+    if (unit == Unit::Byte) {
+        std::array<bool, 256> present{};
+        for (char symbol : text) {
+            present[static_cast<unsigned char>(symbol)] = true;
+        }
+        for (size_t i = 0; i < present.size(); ++i) {
+            if (present[i]) {
+                symbols.push_back(char32_t(i));
+            }
+        }
+    } else {
+        DecodeUtf8(text, symbols, nullptr);
+        std::sort(begin(symbols), end(symbols));
+        symbols.erase(std::unique(begin(symbols), end(symbols)), end(symbols));
+    }
+    return Alphabet(unit, std::move(symbols));
+}
+
+uint32_t Alphabet::GetCode(char32_t symbol, uint32_t unknown) const {
+    if (unit_ == Unit::Byte) {
+        uint32_t code = byte_codes_[symbol];
+        return code == 0 ? unknown : code;
+    }
+    auto it = std::lower_bound(begin(symbols_), end(symbols_), symbol);
+    return it == end(symbols_) || *it != symbol ? unknown : uint32_t(it - begin(symbols_) + 1);
+}
+
+std::vector<uint32_t> Alphabet::EncodeText(std::string_view text,
+                                           std::vector<size_t>* offsets) const {
+    uint32_t unknown = uint32_t(symbols_.size()) + 1;
+    std::vector<uint32_t> result;
+    if (unit_ == Unit::Byte) {
+        result.reserve(text.size());
+        for (size_t i = 0; i < text.size(); ++i) {
+            result.push_back(GetCode(static_cast<unsigned char>(text[i]), unknown));
+            if (offsets != nullptr) {
+                offsets->push_back(i);
+            }
+        }
+        return result;
+    }
+
+    std::vector<char32_t> symbols;
+    DecodeUtf8(text, symbols, offsets);
+    result.reserve(symbols.size());
+    for (char32_t symbol : symbols) {
+        result.push_back(GetCode(symbol, unknown));
+    }
+    return result;
+}
+
+std::vector<uint32_t> Alphabet::EncodePattern(std::string_view pattern,
+                                              std::optional<char32_t> wildcard) const {
+    uint32_t unknown = uint32_t(symbols_.size()) + 2;
+    std::vector<char32_t> symbols;
+    if (unit_ == Unit::Byte) {
+        for (char symbol : pattern) {
+            symbols.push_back(static_cast<unsigned char>(symbol));
+        }
+    } else {
+        DecodeUtf8(pattern, symbols, nullptr);
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(symbols.size());
+    for (char32_t symbol : symbols) {
+        result.push_back(symbol == wildcard ? 0 : GetCode(symbol, unknown));
+    }
+    return result;
+}
+
+double MatchingErrorBound(const std::vector<uint32_t>& text,
+                          const std::vector<uint32_t>& pattern, double epsilon) {
+    size_t pattern_size = pattern.size();
+    if (pattern.empty() || pattern_size > text.size()) {
+        return 0;
+    }
+    //длина куска та же, что у спектра в FindMatchesEncoded
+    size_t length = RoundBlockLength(pattern_size, std::min(kBlockLength, text.size()));
+    size_t step = length - pattern_size + 1;
+
+    //текст кодируется как t + i * t^2, |t + i * t^2|^2 = t^2 + t^4,
+    //наибольшая норма куска считается по префиксным суммам
+    std::vector<double> prefix(text.size() + 1);
+    for (size_t i = 0; i < text.size(); ++i) {
+        double code = text[i];
+        prefix[i + 1] = prefix[i] + code * code + code * code * code * code;
+    }
+    double text_norm = 0;
+    for (size_t begin = 0; begin + pattern_size <= text.size(); begin += step) {
+        size_t end = std::min(text.size(), begin + length);
+        text_norm = std::max(text_norm, std::sqrt(prefix[end] - prefix[begin]));
+    }
+
+    //ядро -2 * p^2 - i * p, |ядра|^2 = 4 * p^4 + p^2
+    double kernel_norm = 0, cube_sum = 0;
+    for (uint32_t value : pattern) {
+        double code = value;
+        kernel_norm += 4 * code * code * code * code + code * code;
+        cube_sum += code * code * code;
+    }
+    kernel_norm = std::sqrt(kernel_norm);
+
+    //оценка Accuracy::ConvolutionErrorBound для свертки куска с ядром
+    //и ошибка округления при прибавлении sum p^3 к свертке
+    double levels = std::max(1.0, std::log2(double(length)));
+    return 5 * epsilon * levels * text_norm * kernel_norm + 2 * epsilon * cube_sum;
+}
+
+template <typename T>
+std::vector<size_t> FindMatchesEncoded(const std::vector<uint32_t>& text,
+                                       const std::vector<uint32_t>& pattern,
+                                       ThreadPool* pool) {
+    if (pattern.empty() || pattern.size() > text.size()) {
+        return {};
+    }
+    //короткому тексту хватит одного куска
+    BasicPatternSpectrum<T> spectrum(pattern, std::min(kBlockLength, text.size()));
+    return FindChunked(text, spectrum, pool);
+}
+
+std::vector<size_t> FindMatchesAlphabet(std::string_view text, std::string_view pattern,
+                                        const Alphabet& alphabet,
+                                        std::optional<char32_t> wildcard, ThreadPool* pool) {
+    std::vector<size_t> offsets;
+    std::vector<uint32_t> text_codes = alphabet.EncodeText(
+        text, alphabet.GetUnit() == Alphabet::Unit::CodePoint ? &offsets : nullptr);
+    std::vector<uint32_t> pattern_codes = alphabet.EncodePattern(pattern, wildcard);
+    if (pattern_codes.empty() || pattern_codes.size() > text_codes.size()) {
+        return {};
+    }
+
+    auto error = [&](double epsilon) {
+        return MatchingErrorBound(text_codes, pattern_codes, epsilon);
+    };
+
+    std::vector<size_t> result;
+    if (error(std::numeric_limits<float>::epsilon()) < kMaxMatchingError) {
+        result = FindMatchesEncoded<std::complex<float>>(text_codes, pattern_codes, pool);
+    } else if (error(std::numeric_limits<double>::epsilon()) < kMaxMatchingError) {
+        result = FindMatchesEncoded<std::complex<double>>(text_codes, pattern_codes, pool);
+    } else {
+        result = FindMatchesEncoded<std::complex<long double>>(text_codes, pattern_codes, pool);
+    }
+
+    if (!offsets.empty()) {
+        for (size_t& position : result) {
+            position = offsets[position];
+        }
+    }
+    return result;
+}
+
+template std::vector<size_t> FindMatchesEncoded<std::complex<float>>(
+    const std::vector<uint32_t>& text, const std::vector<uint32_t>& pattern, ThreadPool* pool);
+template std::vector<size_t> FindMatchesEncoded<std::complex<double>>(
+    const std::vector<uint32_t>& text, const std::vector<uint32_t>& pattern, ThreadPool* pool);
+template std::vector<size_t> FindMatchesEncoded<std::complex<long double>>(
+    const std::vector<uint32_t>& text, const std::vector<uint32_t>& pattern, ThreadPool* pool);
+} // namespace SubstringMatching
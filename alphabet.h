@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "thread_pool.h"
+
+// Кодирование символов для поиска с джокерами через ффт. Критерий
+// sum p * (p - t)^2 = 0 растет как куб кодов, поэтому чем меньше коды, тем грубее
+// может быть точность: алфавит из символов, которые реально встречаются в тексте,
+// с кодами 1..size позволяет искать в double там, где байтам нужен long double.
+// Код 0 зарезервирован за джокером, так что сам джокер настраивается, а любой
+// байт, в том числе '?' и '\0', можно искать буквально
+namespace SubstringMatching {
+class Alphabet {
+ public:
+  enum class Unit {
+    // Символ - байт
+    Byte,
+    // Символ - кодовая точка UTF-8, байт некорректной последовательности
+    // становится отдельным символом 0xDC00 + байт, как в surrogateescape
+    CodePoint,
+  };
+
+  // Все 256 байт, код байта b - b + 1
+  static Alphabet Bytes();
+
+  // Символы, встречающиеся в text, с кодами 1..GetSize() по возрастанию
+  static Alphabet FromText(std::string_view text, Unit unit = Unit::Byte);
+
+  Unit GetUnit() const {
+      return unit_;
+  }
+
+  size_t GetSize() const {
+      return symbols_.size();
+  }
+
+  // Наибольший код, который выдают EncodeText и EncodePattern:
+  // символы не из алфавита в тексте и в шаблоне получают коды GetSize() + 1
+  // и GetSize() + 2, чтобы не совпадать ни с чем
+  uint32_t GetMaxCode() const {
+      return uint32_t(symbols_.size()) + 2;
+  }
+
+  // Коды символов text, в offsets, если он задан, - байтовые смещения символов
+  std::vector<uint32_t> EncodeText(std::string_view text,
+                                   std::vector<size_t>* offsets = nullptr) const;
+
+  // Коды символов pattern, символ wildcard кодируется нулем
+  std::vector<uint32_t> EncodePattern(std::string_view pattern,
+                                      std::optional<char32_t> wildcard) const;
+
+ private:
+  Alphabet(Unit unit, std::vector<char32_t> symbols);
+
+  uint32_t GetCode(char32_t symbol, uint32_t unknown) const;
+
+  Unit unit_;
+  // символы по возрастанию, код symbols_[i] - i + 1
+  std::vector<char32_t> symbols_;
+  // коды байтов для Unit::Byte, 0 - байта нет в алфавите
+  std::array<uint32_t, 256> byte_codes_{};
+};
+
+// Погрешность, после которой округление значения критерия уже не надежно
+const double kMaxMatchingError = 0.25;
+
+// Гарантированная оценка сверху на погрешность значения критерия, которую дает
+// FindMatchesEncoded в типе с машинной точностью epsilon: оценка
+// Accuracy::ConvolutionErrorBound по наибольшей норме куска текста и норме ядра
+// плюс ошибка округления sum p^3
+double MatchingErrorBound(const std::vector<uint32_t>& text,
+                          const std::vector<uint32_t>& pattern, double epsilon);
+
+// Поиск по кодам через FindChunked со спектром BasicPatternSpectrum<T>,
+// код шаблона 0 - джокер. Возвращает номера символов, а не байтов
+template <typename T>
+std::vector<size_t> FindMatchesEncoded(const std::vector<uint32_t>& text,
+                                       const std::vector<uint32_t>& pattern,
+                                       ThreadPool* pool = nullptr);
+
+// Кодирует text и pattern алфавитом и ищет в самой дешевой точности из float,
+// double и long double, для которой MatchingErrorBound меньше kMaxMatchingError:
+// float хватает только коротким текстам и шаблонам в маленьких алфавитах.
+// Возвращает байтовые смещения вхождений
+std::vector<size_t> FindMatchesAlphabet(std::string_view text, std::string_view pattern,
+                                        const Alphabet& alphabet,
+                                        std::optional<char32_t> wildcard = U'?',
+                                        ThreadPool* pool = nullptr);
+
+//Тесты
+void TestAlphabet();
+void TestFindMatchesAlphabet();
+} // namespace SubstringMatching
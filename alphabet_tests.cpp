@@ -0,0 +1,111 @@
+#include "alphabet.h"
+#include "substring_matching.h"
+#include "test_runner.h"
+
+#include <limits>
+
+namespace SubstringMatching {
+void TestAlphabet() {
+    Alphabet compact = Alphabet::FromText("banana");
+    ASSERT_EQUAL(compact.GetSize(), 3u);
+    ASSERT_EQUAL(compact.GetMaxCode(), 5u);
+    ASSERT_EQUAL(compact.EncodeText("banxa"), std::vector<uint32_t>({2, 1, 3, 4, 1}));
+    ASSERT_EQUAL(compact.EncodePattern("a?x", U'?'), std::vector<uint32_t>({1, 0, 5}));
+    ASSERT_EQUAL(compact.EncodePattern("a?x", std::nullopt), std::vector<uint32_t>({1, 5, 5}));
+
+    Alphabet bytes = Alphabet::Bytes();
+    ASSERT_EQUAL(bytes.GetSize(), 256u);
+    std::string binary("\0\xff", 2);
+    ASSERT_EQUAL(bytes.EncodeText(binary), std::vector<uint32_t>({1, 256}));
+
+    //кодовые точки: 'п' - два байта, '€' - три, одиночный 0xff - экранированный байт
+    std::string text = "a\xd0\xbf\xe2\x82\xac\xff";
+    Alphabet utf8 = Alphabet::FromText(text, Alphabet::Unit::CodePoint);
+    ASSERT_EQUAL(utf8.GetSize(), 4u);
+    std::vector<size_t> offsets;
+    ASSERT_EQUAL(utf8.EncodeText(text, &offsets), std::vector<uint32_t>({1, 2, 3, 4}));
+    ASSERT_EQUAL(offsets, std::vector<size_t>({0, 1, 3, 6}));
+    ASSERT_EQUAL(utf8.EncodePattern("\xd0\xbf*", U'*'), std::vector<uint32_t>({2, 0}));
+
+    //обрезанная последовательность и избыточная запись '/' разбираются по байтам
+    Alphabet broken = Alphabet::FromText("\xe2\x82 \xc0\xaf", Alphabet::Unit::CodePoint);
+    ASSERT_EQUAL(broken.GetSize(), 5u);
+
+    //для короткого текста из двух символов хватает float
+    std::vector<uint32_t> short_text(64), short_pattern = {1, 0, 2, 1};
+    for (size_t i = 0; i < short_text.size(); ++i) {
+        short_text[i] = 1 + i % 2;
+    }
+    ASSERT(MatchingErrorBound(short_text, short_pattern, std::numeric_limits<float>::epsilon()) <
+           kMaxMatchingError);
+
+    //длинный шаблон из одного символа: ошибки коррелированы, float не годится
+    std::vector<uint32_t> long_text(100000, 3), long_pattern(16384, 3);
+    ASSERT(MatchingErrorBound(long_text, long_pattern, std::numeric_limits<float>::epsilon()) >
+           kMaxMatchingError);
+    ASSERT(MatchingErrorBound(long_text, long_pattern, std::numeric_limits<double>::epsilon()) <
+           kMaxMatchingError);
+}
+
+void TestFindMatchesAlphabet() {
+    std::string dna;
+    for (size_t i = 0; i < 20000; ++i) {
+        dna.push_back("ACGT"[(i * i + i / 3) % 4]);
+    }
+    std::string pattern = dna.substr(5000, 300);
+    for (size_t i = 0; i < pattern.size(); i += 3) {
+        pattern[i] = 'N';
+    }
+    Alphabet alphabet = Alphabet::FromText(dna);
+    std::vector<size_t> expected;
+    {
+        std::string question = pattern;
+        std::replace(begin(question), end(question), 'N', '?');
+        expected = FindMatches(dna, question);
+    }
+    ASSERT(!expected.empty());
+    ThreadPool pool(2);
+    ASSERT_EQUAL(FindMatchesAlphabet(dna, pattern, alphabet, U'N'), expected);
+    ASSERT_EQUAL(FindMatchesAlphabet(dna, pattern, alphabet, U'N', &pool), expected);
+    std::vector<uint32_t> text_codes = alphabet.EncodeText(dna);
+    std::vector<uint32_t> pattern_codes = alphabet.EncodePattern(pattern, U'N');
+    ASSERT_EQUAL(FindMatchesEncoded<std::complex<float>>(text_codes, pattern_codes), expected);
+
+    //тот же поиск по кускам работает с кодами и с байтами в любой точности
+    BasicPatternSpectrum<std::complex<float>> coded(pattern_codes, 1024);
+    ASSERT_EQUAL(coded.GetBlockLength(), 1024u);
+    ASSERT_EQUAL(FindChunked(text_codes, coded, &pool), expected);
+    ASSERT_EQUAL(FindChunked(dna, BasicPatternSpectrum<std::complex<double>>(pattern, 'N')),
+                 expected);
+
+    //'?' ищется буквально, если джокер другой, и байты старше 127 тоже
+    std::string binary("a?\xff\0b?\xff", 7);
+    ASSERT_EQUAL(FindMatchesAlphabet(binary, "?\xff", Alphabet::Bytes(), U'*'),
+                 std::vector<size_t>({1, 5}));
+    ASSERT_EQUAL(FindMatchesAlphabet(binary, std::string("*\0", 2), Alphabet::Bytes(), U'*'),
+                 std::vector<size_t>({2}));
+    ASSERT_EQUAL(FindMatchesFFT(binary, "?\xff"), std::vector<size_t>({1, 5}));
+
+    //длинный шаблон из старших байтов: суммы кодов не помещаются в int
+    std::string high(228, '\xff');
+    std::string high_pattern(128, '\xff');
+    ASSERT_EQUAL(FindMatchesFFT(high, high_pattern).size(), 101u);
+    ASSERT_EQUAL(FindSubstringsFFT(high, high_pattern).size(), 101u);
+    ASSERT_EQUAL(FindMatchesAlphabet(high, high_pattern, Alphabet::Bytes()).size(), 101u);
+
+    //сумма критерия около 2 * 10^6 при коррелированных ошибках ффт
+    std::string repeated = "AB" + std::string(99998, 'C');
+    std::string long_pattern(16384, 'C');
+    Alphabet abc = Alphabet::FromText(repeated);
+    std::vector<size_t> repeated_matches = FindMatchesAlphabet(repeated, long_pattern, abc);
+    ASSERT_EQUAL(repeated_matches.size(), 83615u);
+    ASSERT_EQUAL(repeated_matches.front(), 2u);
+
+    //смещения в байтах для кодовых точек
+    std::string russian = "мама мыла раму";
+    Alphabet letters = Alphabet::FromText(russian, Alphabet::Unit::CodePoint);
+    ASSERT_EQUAL(FindMatchesAlphabet(russian, "м?", letters),
+                 std::vector<size_t>({0, 4, 9, 22}));
+    ASSERT(FindMatchesAlphabet(russian, "мир", letters).empty());
+}
+} // namespace SubstringMatching
@@ -0,0 +1,175 @@
+#include "async_operations.h"
+#include "fft.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Async {
+    template <typename T>
+    std::future<std::vector<T>> FastFourierTransformAsync(std::vector<T> data, ThreadPool& pool) {
+        return pool.Submit([data = std::move(data)] {
+            return FFT::FastFourierTransform(data);
+        });
+    }
+
+    template <typename T>
+    std::future<std::vector<T>> FastInverseFourierTransformAsync(std::vector<T> data,
+                                                                 ThreadPool& pool) {
+        return pool.Submit([data = std::move(data)] {
+            return FFT::FastInverseFourierTransform(data);
+        });
+    }
+
+    template <typename T>
+    void MultiplyAsync(const Polynomial<T>& first, const Polynomial<T>& second,
+                       std::function<void(Polynomial<T>)> on_result,
+                       std::function<void(std::exception_ptr)> on_error,
+                       ThreadPool& pool) {
+        //общее состояние стадий одного умножения, последняя из прямых
+        //стадий ставит в очередь стадию произведения и обратного преобразования
+        struct State {
+          std::vector<T> first_values;
+          std::vector<T> second_values;
+          size_t future_degree = 0;
+          std::atomic<size_t> remaining{2};
+          std::atomic<bool> failed{false};
+          std::function<void(Polynomial<T>)> on_result;
+          std::function<void(std::exception_ptr)> on_error;
+        };
+
+        //у произведения с пустым множителем коэффициентов нет, а длина
+        //first.GetDegree() + second.GetDegree() - 1 ушла бы в SIZE_MAX
+        if (first.GetDegree() == 0 || second.GetDegree() == 0) {
+            pool.Execute([on_result = std::move(on_result)] {
+                try {
+                    on_result(Polynomial<T>(std::vector<T>()));
+                } catch (...) {
+                }
+            });
+            return;
+        }
+
+        auto state = std::make_shared<State>();
+        state->future_degree = first.GetDegree() + second.GetDegree() - 1;
+        state->on_result = std::move(on_result);
+        state->on_error = std::move(on_error);
+
+        size_t new_deg = 1;
+        while (new_deg < state->future_degree) {
+            new_deg *= 2;
+        }
+
+        //исключение из обратного вызова некому передать, а выйдя из задачи пула,
+        //оно завершило бы процесс, поэтому оно отбрасывается
+        auto fail = [state] {
+            if (!state->failed.exchange(true) && state->on_error) {
+                try {
+                    state->on_error(std::current_exception());
+                } catch (...) {
+                }
+            }
+        };
+
+        auto multiply_stage = [state, fail] {
+            std::vector<T> coefficients;
+            try {
+                std::vector<T>& values = state->first_values;
+                for (size_t i = 0; i < values.size(); ++i) {
+                    values[i] *= state->second_values[i];
+                }
+                coefficients = FFT::FastInverseFourierTransform(values);
+                coefficients.resize(state->future_degree);
+            } catch (...) {
+                fail();
+                return;
+            }
+
+            //on_result зовется вне try: его исключение - не ошибка умножения
+            try {
+                state->on_result(Polynomial<T>(coefficients));
+            } catch (...) {
+            }
+        };
+
+        auto forward_stage = [state, fail, multiply_stage, pool_ptr = &pool](
+            const std::vector<T>& coefficients, std::vector<T>& values, size_t new_deg) {
+            try {
+                values = FFT::FastFourierTransform(FFT::AddPadding<T>(coefficients, new_deg));
+            } catch (...) {
+                fail();
+            }
+            if (--state->remaining == 0 && !state->failed) {
+                pool_ptr->Execute(multiply_stage);
+            }
+        };
+
+        pool.Execute([forward_stage, state, coefficients = first.GetCoefficients(), new_deg] {
+            forward_stage(coefficients, state->first_values, new_deg);
+        });
+        pool.Execute([forward_stage, state, coefficients = second.GetCoefficients(), new_deg] {
+            forward_stage(coefficients, state->second_values, new_deg);
+        });
+    }
+
+    template <typename T>
+    std::future<Polynomial<T>> MultiplyAsync(const Polynomial<T>& first,
+                                             const Polynomial<T>& second,
+                                             ThreadPool& pool) {
+        auto promise = std::make_shared<std::promise<Polynomial<T>>>();
+        std::future<Polynomial<T>> result = promise->get_future();
+
+        MultiplyAsync<T>(
+            first, second,
+            [promise](Polynomial<T> product) {
+                promise->set_value(std::move(product));
+            },
+            [promise](std::exception_ptr error) {
+                promise->set_exception(error);
+            },
+            pool);
+
+        return result;
+    }
+
+
+    template std::future<std::vector<std::complex<float>>>
+    FastFourierTransformAsync(std::vector<std::complex<float>> data, ThreadPool& pool);
+    template std::future<std::vector<std::complex<double>>>
+    FastFourierTransformAsync(std::vector<std::complex<double>> data, ThreadPool& pool);
+    template std::future<std::vector<std::complex<long double>>>
+    FastFourierTransformAsync(std::vector<std::complex<long double>> data, ThreadPool& pool);
+
+    template std::future<std::vector<std::complex<float>>>
+    FastInverseFourierTransformAsync(std::vector<std::complex<float>> data, ThreadPool& pool);
+    template std::future<std::vector<std::complex<double>>>
+    FastInverseFourierTransformAsync(std::vector<std::complex<double>> data, ThreadPool& pool);
+    template std::future<std::vector<std::complex<long double>>>
+    FastInverseFourierTransformAsync(std::vector<std::complex<long double>> data,
+                                     ThreadPool& pool);
+
+    template std::future<Polynomial<std::complex<float>>>
+    MultiplyAsync(const Polynomial<std::complex<float>>& first,
+                  const Polynomial<std::complex<float>>& second, ThreadPool& pool);
+    template std::future<Polynomial<std::complex<double>>>
+    MultiplyAsync(const Polynomial<std::complex<double>>& first,
+                  const Polynomial<std::complex<double>>& second, ThreadPool& pool);
+    template std::future<Polynomial<std::complex<long double>>>
+    MultiplyAsync(const Polynomial<std::complex<long double>>& first,
+                  const Polynomial<std::complex<long double>>& second, ThreadPool& pool);
+
+    template void
+    MultiplyAsync(const Polynomial<std::complex<float>>& first,
+                  const Polynomial<std::complex<float>>& second,
+                  std::function<void(Polynomial<std::complex<float>>)> on_result,
+                  std::function<void(std::exception_ptr)> on_error, ThreadPool& pool);
+    template void
+    MultiplyAsync(const Polynomial<std::complex<double>>& first,
+                  const Polynomial<std::complex<double>>& second,
+                  std::function<void(Polynomial<std::complex<double>>)> on_result,
+                  std::function<void(std::exception_ptr)> on_error, ThreadPool& pool);
+    template void
+    MultiplyAsync(const Polynomial<std::complex<long double>>& first,
+                  const Polynomial<std::complex<long double>>& second,
+                  std::function<void(Polynomial<std::complex<long double>>)> on_result,
+                  std::function<void(std::exception_ptr)> on_error, ThreadPool& pool);
+}
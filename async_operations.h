@@ -0,0 +1,45 @@
+#pragma once
+
+#include <complex>
+#include <exception>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "polynomial.h"
+#include "thread_pool.h"
+
+// Асинхронные преобразования и умножения: вызов сразу возвращает управление,
+// стадии (два прямых преобразования, поточечное произведение с обратным)
+// выполняются отдельными задачами пула, поэтому поток запросов
+// проходит через них конвейером
+namespace Async {
+template <typename T>
+std::future<std::vector<T>> FastFourierTransformAsync(
+    std::vector<T> data, ThreadPool& pool = GetDefaultThreadPool());
+
+template <typename T>
+std::future<std::vector<T>> FastInverseFourierTransformAsync(
+    std::vector<T> data, ThreadPool& pool = GetDefaultThreadPool());
+
+// Произведение многочленов, результат приходит через future
+template <typename T>
+std::future<Polynomial<T>> MultiplyAsync(
+    const Polynomial<T>& first, const Polynomial<T>& second,
+    ThreadPool& pool = GetDefaultThreadPool());
+
+// Произведение многочленов, по готовности вызывается on_result
+// (или on_error, если при вычислении было исключение) в потоке пула.
+// Исключения из самих on_result и on_error перехватываются и отбрасываются
+template <typename T>
+void MultiplyAsync(
+    const Polynomial<T>& first, const Polynomial<T>& second,
+    std::function<void(Polynomial<T>)> on_result,
+    std::function<void(std::exception_ptr)> on_error = nullptr,
+    ThreadPool& pool = GetDefaultThreadPool());
+
+//Тесты
+void TestTransformAsync();
+void TestMultiplyAsync();
+void TestMultiplyCallback();
+} // namespace Async
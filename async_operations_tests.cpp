@@ -0,0 +1,88 @@
+#include "async_operations.h"
+#include "fft.h"
+#include "test_runner.h"
+
+#include <atomic>
+
+namespace Async {
+void TestTransformAsync() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-5;
+    ThreadPool pool(2);
+
+    vector<complex<double>> v1 = {8, 7, 6, 5, 4, 3, 2, 1, 1, 2, 3, 4, 5, 6, 7, 8};
+    auto forward = FastFourierTransformAsync(v1, pool);
+    vector<complex<double>> values = forward.get();
+    ASSERT_VECTOR(values, FFT::FastFourierTransform(v1), error);
+    ASSERT_VECTOR(FastInverseFourierTransformAsync(values, pool).get(), v1, error);
+}
+
+void TestMultiplyAsync() {
+    using std::complex;
+
+    ThreadPool pool(3);
+
+    Polynomial<complex<long double>>
+        p1({7, 2, 13, 6}),
+        p2({3, 1, 0, 0, 5, 8, 9}),
+        p3({21, 13, 41, 31, 41, 66, 144, 152, 165, 54});
+
+    //поток запросов проходит через стадии конвейером
+    std::vector<std::future<Polynomial<complex<long double>>>> products;
+    for (size_t i = 0; i < 20; ++i) {
+        products.push_back(MultiplyAsync(p1, p2, pool));
+    }
+    for (auto& product : products) {
+        Polynomial<complex<long double>> result = product.get();
+        ASSERT_EQUAL(result.GetDegree(), p3.GetDegree());
+        ASSERT_EQUAL(result, p3);
+    }
+
+    ASSERT_EQUAL(MultiplyAsync(p1, Polynomial<complex<long double>>({1}), pool).get(), p1);
+
+    //пустой множитель: произведение пусто, и ни одна стадия не запускается
+    Polynomial<complex<long double>> empty(std::vector<complex<long double>>{});
+    ASSERT_EQUAL(MultiplyAsync(p1, empty, pool).get().GetDegree(), 0u);
+    ASSERT_EQUAL(MultiplyAsync(empty, p1, pool).get().GetDegree(), 0u);
+    ASSERT_EQUAL(MultiplyAsync(empty, empty, pool).get().GetDegree(), 0u);
+}
+
+void TestMultiplyCallback() {
+    using std::complex;
+
+    ThreadPool pool(2);
+
+    Polynomial<complex<double>> p1({1, 2, 3}), p2({3, 2, 1}), p3({3, 8, 14, 8, 3});
+
+    std::promise<Polynomial<complex<double>>> promise;
+    MultiplyAsync<complex<double>>(
+        p1, p2,
+        [&promise](Polynomial<complex<double>> product) {
+            promise.set_value(std::move(product));
+        },
+        nullptr, pool);
+
+    ASSERT_EQUAL(promise.get_future().get(), p3);
+
+    //исключение из on_result не вызывает on_error и не выходит из задачи пула
+    ThreadPool single(1);
+    std::atomic<bool> error_called{false};
+    std::promise<void> called;
+    MultiplyAsync<complex<double>>(
+        p1, p2,
+        [&called](Polynomial<complex<double>>) {
+            called.set_value();
+            throw std::runtime_error("callback failed");
+        },
+        [&error_called](std::exception_ptr) {
+            error_called = true;
+        },
+        single);
+    called.get_future().wait();
+    //в пуле из одного потока следующее умножение закончится после предыдущей задачи
+    ASSERT_EQUAL(MultiplyAsync(p1, p2, single).get(), p3);
+    ASSERT(!error_called);
+}
+} // namespace Async
@@ -0,0 +1,408 @@
+#include "benchmark.h"
+#include "alphabet.h"
+#include "fft.h"
+#include "polynomial.h"
+#include "substring_matching.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+//одна выборка длится не меньше этого времени
+const std::chrono::nanoseconds kMinSampleTime = std::chrono::milliseconds(1);
+
+//результат замеряемой функции складывается сюда, чтобы компилятор ее не выбросил
+volatile double sink = 0;
+
+//модель числа операций для преобразования длины n = 2^k
+double FourierTransformFlops(size_t degree) {
+    return 5.0 * degree * std::log2(double(degree));
+}
+
+double Percentile(const std::vector<double>& sorted, double fraction) {
+    size_t index = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::max<size_t>(index, 1) - 1];
+}
+
+std::string MakeText(size_t size, unsigned seed) {
+    std::string result(size, 'a');
+    for (auto& symbol : result) {
+        seed = seed * 1103515245 + 12345;
+        symbol = "ab"[(seed >> 16) % 2];
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<T> MakeData(size_t size) {
+    std::vector<T> result(size);
+    for (size_t i = 0; i < size; ++i) {
+        result[i] = T(i % 17, i % 5);
+    }
+    return result;
+}
+
+std::string ExtractField(const std::string& object, const std::string& key) {
+    std::string marker = "\"" + key + "\": ";
+    size_t begin = object.find(marker);
+    if (begin == std::string::npos) {
+        std::ostringstream os;
+        os << "Exception thrown in Benchmark::ParseJson, missing field " << key << "\n";
+        throw std::runtime_error(os.str());
+    }
+    begin += marker.size();
+    if (object[begin] == '"') {
+        return object.substr(begin + 1, object.find('"', begin + 1) - begin - 1);
+    }
+    return object.substr(begin, object.find_first_of(",}", begin) - begin);
+}
+
+//замеряет func, если имя подходит под фильтр, и показывает прогресс
+void AddIfSelected(std::vector<Benchmark::Result>& results, const Benchmark::Options& options,
+                   const std::string& name, size_t size, double flops,
+                   const std::function<void()>& func) {
+    if (name.find(options.filter) != std::string::npos) {
+        results.push_back(Benchmark::Measure(name, size, flops, func, options.samples));
+        std::cerr << "." << std::flush;
+    }
+}
+
+template <typename T>
+void AddFourierTransforms(std::vector<Benchmark::Result>& results,
+                          const Benchmark::Options& options, const std::string& type) {
+    auto add = [&results, &options](const std::string& name, size_t size, double flops,
+                                    const std::function<void()>& func) {
+        AddIfSelected(results, options, name, size, flops, func);
+    };
+
+    for (size_t degree = size_t(1) << 8; degree <= (size_t(1) << 16); degree *= 4) {
+        std::vector<T> data = MakeData<T>(degree);
+        add("FastFourierTransform<" + type + ">", degree, FourierTransformFlops(degree), [&data] {
+            sink = sink + std::real(FFT::FastFourierTransform(data)[1]);
+        });
+
+        FFT::Plan<T> plan(degree);
+        std::vector<T> work = data;
+        //прямое и обратное вместе, иначе значения растут от повтора к повтору
+        add("Plan::Forward+Inverse<" + type + ">", degree, 2 * FourierTransformFlops(degree),
+            [&plan, &work] {
+                plan.Forward(work.data());
+                plan.Inverse(work.data());
+                sink = sink + std::real(work[1]);
+            });
+    }
+
+    //длины не степени двойки дополняются нулями, как это делает пользователь
+    for (size_t size : {1000, 10000, 50000}) {
+        std::vector<T> data = MakeData<T>(size);
+        size_t degree = 1;
+        while (degree < size) {
+            degree *= 2;
+        }
+        add("FastFourierTransform+AddPadding<" + type + ">", size, FourierTransformFlops(degree),
+            [&data, degree] {
+                std::vector<T> padded = FFT::AddPadding(data, degree);
+                sink = sink + std::real(FFT::FastFourierTransform(padded)[1]);
+            });
+    }
+}
+}
+
+namespace Benchmark {
+Options ParseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 0; i < argc; ++i) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        std::string key = argument.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+
+        if (key == "--filter") {
+            options.filter = value;
+        } else if (key == "--json") {
+            options.json_path = value;
+        } else if (key == "--baseline") {
+            options.baseline_path = value;
+        } else if (key == "--threshold" || key == "--samples") {
+            //std::stod и std::stoul бросают std::invalid_argument и std::out_of_range
+            try {
+                if (key == "--threshold") {
+                    options.threshold = std::stod(value);
+                } else {
+                    options.samples = std::max<size_t>(1, std::stoul(value));
+                }
+            } catch (std::logic_error&) {
+                std::ostringstream os;
+                os << "Exception thrown in Benchmark::ParseOptions, invalid number in "
+                   << argument << "\n";
+                throw std::runtime_error(os.str());
+            }
+        } else {
+            std::ostringstream os;
+            os << "Exception thrown in Benchmark::ParseOptions, unknown option "
+               << argument << "\n";
+            throw std::runtime_error(os.str());
+        }
+    }
+    return options;
+}
+
+Result Measure(const std::string& name, size_t size, double flops,
+               const std::function<void()>& func, size_t samples) {
+    using Clock = std::chrono::steady_clock;
+
+    //прогрев и калибровка числа повторов в одной выборке
+    auto start = Clock::now();
+    func();
+    auto once = std::max(Clock::now() - start, Clock::duration(1));
+    size_t iterations = std::max<size_t>(1, kMinSampleTime / once);
+
+    std::vector<double> times(samples);
+    SetAllocationCounting(true);
+    size_t bytes_before = GetAllocatedBytes(), count_before = GetAllocationCount();
+    for (auto& time : times) {
+        start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            func();
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        time = elapsed.count() / iterations;
+    }
+    size_t allocated = GetAllocatedBytes() - bytes_before;
+    size_t allocations = GetAllocationCount() - count_before;
+    SetAllocationCounting(false);
+    size_t operations = samples * iterations;
+
+    std::sort(times.begin(), times.end());
+    Result result;
+    result.name = name;
+    result.size = size;
+    result.iterations = operations;
+    result.p50_ns = Percentile(times, 0.5);
+    result.p90_ns = Percentile(times, 0.9);
+    result.p99_ns = Percentile(times, 0.99);
+    result.gflops = flops / result.p50_ns;
+    result.bytes_per_op = double(allocated) / operations;
+    result.allocations_per_op = double(allocations) / operations;
+    return result;
+}
+
+std::vector<Result> RunAll(const Options& options) {
+    std::vector<Result> results;
+    auto add = [&results, &options](const std::string& name, size_t size, double flops,
+                                    const std::function<void()>& func) {
+        AddIfSelected(results, options, name, size, flops, func);
+    };
+
+    AddFourierTransforms<std::complex<float>>(results, options, "float");
+    AddFourierTransforms<std::complex<double>>(results, options, "double");
+    AddFourierTransforms<std::complex<long double>>(results, options, "long double");
+
+    using Complex = std::complex<long double>;
+    for (size_t size = size_t(1) << 8; size <= (size_t(1) << 14); size *= 4) {
+        Polynomial<Complex> first(MakeData<Complex>(size)), second(MakeData<Complex>(size));
+        //три преобразования длины 2 * size и поточечное произведение
+        double flops = 3 * FourierTransformFlops(2 * size) + 6.0 * 2 * size;
+        add("Polynomial::operator*=", size, flops, [&first, &second] {
+            Polynomial<Complex> product = first;
+            product *= second;
+            sink = sink + std::real(product.GetCoefficients()[0]);
+        });
+    }
+    for (size_t pow : {4, 16, 64}) {
+        Polynomial<Complex> base({1, 1});
+        add("Polynomial::operator^=", pow, 0, [&base, pow] {
+            Polynomial<Complex> power = base;
+            power ^= pow;
+            sink = sink + std::real(power.GetCoefficients()[0]);
+        });
+    }
+
+    const std::string pattern = "abba?bab", exact_pattern = "abbaabab";
+    for (size_t size : {1 << 10, 1 << 13, 1 << 16}) {
+        std::string text = MakeText(size, 7);
+        double quadratic_flops = 2.0 * size * pattern.size();
+        add("SubstringMatching::FindSubstrings", size, quadratic_flops, [&text, &exact_pattern] {
+            sink = sink + SubstringMatching::FindSubstrings(text, exact_pattern).size();
+        });
+        add("SubstringMatching::FindSubstringsFFT", size, 0, [&text, &exact_pattern] {
+            sink = sink + SubstringMatching::FindSubstringsFFT(text, exact_pattern).size();
+        });
+        add("SubstringMatching::FindMatches", size, quadratic_flops, [&text, &pattern] {
+            sink = sink + SubstringMatching::FindMatches(text, pattern).size();
+        });
+        add("SubstringMatching::FindMatchesFFT", size, 0, [&text, &pattern] {
+            sink = sink + SubstringMatching::FindMatchesFFT(text, pattern).size();
+        });
+        add("SubstringMatching::FindMatchesChunked", size, 0, [&text, &pattern] {
+            sink = sink + SubstringMatching::FindMatchesChunked(text, pattern).size();
+        });
+        add("SubstringMatching::FindMatchesAlphabet", size, 0, [&text, &pattern] {
+            SubstringMatching::Alphabet alphabet = SubstringMatching::Alphabet::FromText(text);
+            sink = sink + SubstringMatching::FindMatchesAlphabet(text, pattern, alphabet).size();
+        });
+        add("SubstringMatching::FindMatchesChunked/pool", size, 0, [&text, &pattern] {
+            sink = sink + SubstringMatching::FindMatchesChunked(text, pattern,
+                                                                &GetDefaultThreadPool()).size();
+        });
+    }
+    //много коротких документов: по вызову на документ и одним пакетом
+    for (size_t count : {256, 2048}) {
+        std::vector<std::string> storage;
+        for (size_t i = 0; i < count; ++i) {
+            storage.push_back(MakeText(500, i));
+        }
+        std::vector<std::string_view> documents(begin(storage), end(storage));
+        add("SubstringMatching::FindMatchesChunked/documents", count, 0, [&storage, &pattern] {
+            for (const auto& document : storage) {
+                sink = sink + SubstringMatching::FindMatchesChunked(document, pattern).size();
+            }
+        });
+        add("SubstringMatching::FindMatchesBatch", count, 0, [&documents, &pattern] {
+            sink = sink + SubstringMatching::FindMatchesBatch(documents, pattern).size();
+        });
+    }
+    std::cerr << "\n";
+
+    return results;
+}
+
+std::string ToJson(const std::vector<Result>& results) {
+    std::ostringstream os;
+    os << std::setprecision(10);
+    os << "{\"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        os << "  {\"name\": \"" << result.name << "\", "
+           << "\"size\": " << result.size << ", "
+           << "\"iterations\": " << result.iterations << ", "
+           << "\"p50_ns\": " << result.p50_ns << ", "
+           << "\"p90_ns\": " << result.p90_ns << ", "
+           << "\"p99_ns\": " << result.p99_ns << ", "
+           << "\"gflops\": " << result.gflops << ", "
+           << "\"bytes_per_op\": " << result.bytes_per_op << ", "
+           << "\"allocations_per_op\": " << result.allocations_per_op << "}"
+           << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "]}\n";
+    return os.str();
+}
+
+std::vector<Result> ParseJson(const std::string& json) {
+    std::vector<Result> results;
+    std::istringstream is(json);
+    std::string line;
+    while (std::getline(is, line)) {
+        if (line.find("\"name\"") == std::string::npos) {
+            continue;
+        }
+        Result result;
+        result.name = ExtractField(line, "name");
+        result.size = std::stoul(ExtractField(line, "size"));
+        result.iterations = std::stoul(ExtractField(line, "iterations"));
+        result.p50_ns = std::stod(ExtractField(line, "p50_ns"));
+        result.p90_ns = std::stod(ExtractField(line, "p90_ns"));
+        result.p99_ns = std::stod(ExtractField(line, "p99_ns"));
+        result.gflops = std::stod(ExtractField(line, "gflops"));
+        result.bytes_per_op = std::stod(ExtractField(line, "bytes_per_op"));
+        result.allocations_per_op = std::stod(ExtractField(line, "allocations_per_op"));
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::vector<std::string> FindRegressions(const std::vector<Result>& current,
+                                         const std::vector<Result>& baseline,
+                                         double threshold) {
+    std::vector<std::string> result;
+    for (const auto& measured : current) {
+        auto it = std::find_if(baseline.begin(), baseline.end(), [&measured](const Result& old) {
+            return old.name == measured.name && old.size == measured.size;
+        });
+        if (it != baseline.end() && measured.p50_ns > it->p50_ns * (1 + threshold)) {
+            std::ostringstream os;
+            os << measured.name << " [" << measured.size << "]: " << it->p50_ns
+               << " ns -> " << measured.p50_ns << " ns";
+            result.push_back(os.str());
+        }
+    }
+    return result;
+}
+
+int Main(int argc, char* argv[]) {
+    //параметры, baseline и файл для json проверяются до замеров, которые идут минутами
+    Options options;
+    std::vector<Result> baseline;
+    std::ofstream json_file;
+    try {
+        options = ParseOptions(argc, argv);
+        if (!options.baseline_path.empty()) {
+            std::ifstream baseline_file(options.baseline_path);
+            if (!baseline_file) {
+                std::ostringstream os;
+                os << "Exception thrown in Benchmark::Main, cannot open baseline "
+                   << options.baseline_path << "\n";
+                throw std::runtime_error(os.str());
+            }
+            std::stringstream contents;
+            contents << baseline_file.rdbuf();
+            baseline = ParseJson(contents.str());
+        }
+        if (!options.json_path.empty()) {
+            json_file.open(options.json_path);
+            if (!json_file) {
+                std::ostringstream os;
+                os << "Exception thrown in Benchmark::Main, cannot open "
+                   << options.json_path << " for writing\n";
+                throw std::runtime_error(os.str());
+            }
+        }
+    } catch (std::exception& error) {
+        std::cerr << error.what();
+        return 2;
+    }
+    std::vector<Result> results = RunAll(options);
+
+    std::cout << std::left << std::setw(48) << "name" << std::right
+              << std::setw(8) << "size" << std::setw(14) << "ns/op"
+              << std::setw(14) << "p90 ns" << std::setw(14) << "p99 ns"
+              << std::setw(10) << "GFLOP/s" << std::setw(12) << "B/op"
+              << std::setw(10) << "allocs" << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(48) << result.name << std::right
+                  << std::setw(8) << result.size << std::setw(14) << result.p50_ns
+                  << std::setw(14) << result.p90_ns << std::setw(14) << result.p99_ns
+                  << std::setw(10) << std::setprecision(2) << result.gflops
+                  << std::setw(12) << std::setprecision(0) << result.bytes_per_op
+                  << std::setw(10) << std::setprecision(1) << result.allocations_per_op
+                  << "\n";
+    }
+
+    if (json_file.is_open()) {
+        json_file << ToJson(results);
+        json_file.close();
+        if (!json_file) {
+            std::cerr << "Exception thrown in Benchmark::Main, cannot write "
+                      << options.json_path << "\n";
+            return 2;
+        }
+    }
+
+    if (options.baseline_path.empty()) {
+        return 0;
+    }
+    std::vector<std::string> regressions = FindRegressions(results, baseline, options.threshold);
+    for (const auto& regression : regressions) {
+        std::cout << "REGRESSION " << regression << "\n";
+    }
+    return regressions.empty() ? 0 : 1;
+}
+} // namespace Benchmark
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Замеры производительности: запуск main --benchmark [параметры] в сборке с FFT_BENCHMARK.
+// Каждый замер калибруется так, чтобы одна выборка шла не меньше миллисекунды,
+// время операции - медиана по выборкам, выделения памяти считаются
+// подменой глобального operator new только во время выборок. Подмена живет в
+// benchmark_allocations.cpp и включается тем же FFT_BENCHMARK, так что в обычной
+// сборке operator new стандартный, а счетчики выделений всегда нулевые
+namespace Benchmark {
+struct Options {
+  // Запускаются только замеры, в имени которых есть filter
+  std::string filter;
+  // Куда записать результаты в JSON, пусто - не записывать
+  std::string json_path;
+  // Результаты прошлого запуска для сравнения, пусто - не сравнивать
+  std::string baseline_path;
+  // Допустимое относительное замедление по сравнению с baseline
+  double threshold = 0.1;
+  size_t samples = 15;
+};
+
+struct Result {
+  std::string name;
+  size_t size = 0;
+  size_t iterations = 0;
+  // Перцентили времени одной операции по выборкам, нс
+  double p50_ns = 0;
+  double p90_ns = 0;
+  double p99_ns = 0;
+  // 0, если для операции нет модели числа операций с плавающей точкой
+  double gflops = 0;
+  double bytes_per_op = 0;
+  double allocations_per_op = 0;
+};
+
+// Разбирает параметры --filter=, --json=, --baseline=, --threshold=, --samples=,
+// выбрасывает std::runtime_error на неизвестный параметр или неверное число
+Options ParseOptions(int argc, char* argv[]);
+
+// Замеряет func, flops - число операций с плавающей точкой за один вызов
+Result Measure(const std::string& name, size_t size, double flops,
+               const std::function<void()>& func, size_t samples);
+
+// Все замеры: преобразование Фурье трех точностей, умножение и степень многочленов,
+// поиск подстрок быстрыми и квадратичными алгоритмами
+std::vector<Result> RunAll(const Options& options);
+
+// Один результат на строку, чтобы ParseJson мог читать файл без полноценного разбора JSON
+std::string ToJson(const std::vector<Result>& results);
+
+std::vector<Result> ParseJson(const std::string& json);
+
+// Описания замеров, которые медленнее baseline больше чем в 1 + threshold раз
+std::vector<std::string> FindRegressions(const std::vector<Result>& current,
+                                         const std::vector<Result>& baseline,
+                                         double threshold);
+
+// Счетчики подмененного operator new (benchmark_allocations.cpp). Выделения
+// считаются, только пока включен подсчет, иначе operator new не трогает
+// атомарные счетчики
+size_t GetAllocatedBytes();
+size_t GetAllocationCount();
+
+// Включает подсчет выделений, Measure включает его на время выборок
+void SetAllocationCounting(bool enabled);
+
+// Точка входа режима --benchmark, возвращает 1, если найдены регрессии,
+// и 2, если параметры неверны, baseline не читается или json не записывается.
+// Файлы проверяются до замеров
+int Main(int argc, char* argv[]);
+
+//Тесты
+void TestMeasure();
+void TestJson();
+} // namespace Benchmark
@@ -0,0 +1,168 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Подмена глобальных operator new и operator delete для подсчета выделений.
+// Собирается только в сборке замеров с FFT_BENCHMARK, остальные сборки
+// пользуются стандартными operator new и получают нулевые счетчики
+#ifdef FFT_BENCHMARK
+namespace {
+std::atomic<bool> count_allocations{false};
+std::atomic<size_t> allocated_bytes{0};
+std::atomic<size_t> allocation_count{0};
+
+void CountAllocation(size_t size) {
+    //вне замеров - одно чтение флага вместо двух атомарных сложений
+    if (count_allocations.load(std::memory_order_relaxed)) {
+        allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void* Allocate(size_t size) {
+    CountAllocation(size);
+    if (void* result = std::malloc(size == 0 ? 1 : size)) {
+        return result;
+    }
+    throw std::bad_alloc();
+}
+
+void* AllocateAligned(size_t size, std::align_val_t alignment) {
+    CountAllocation(size);
+    //std::aligned_alloc требует размер, кратный выравниванию
+    size_t align = static_cast<size_t>(alignment);
+    size_t rounded = (std::max<size_t>(size, 1) + align - 1) / align * align;
+    if (void* result = std::aligned_alloc(align, rounded)) {
+        return result;
+    }
+    throw std::bad_alloc();
+}
+}
+
+void* operator new(size_t size) {
+    return Allocate(size);
+}
+
+void* operator new[](size_t size) {
+    return Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return AllocateAligned(size, alignment);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return Allocate(size);
+    } catch (std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return Allocate(size);
+    } catch (std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return AllocateAligned(size, alignment);
+    } catch (std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return AllocateAligned(size, alignment);
+    } catch (std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+//std::aligned_alloc и std::malloc освобождаются одним std::free
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+namespace Benchmark {
+size_t GetAllocatedBytes() {
+    return allocated_bytes.load(std::memory_order_relaxed);
+}
+
+size_t GetAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+void SetAllocationCounting(bool enabled) {
+    count_allocations.store(enabled, std::memory_order_relaxed);
+}
+} // namespace Benchmark
+#else
+namespace Benchmark {
+size_t GetAllocatedBytes() {
+    return 0;
+}
+
+size_t GetAllocationCount() {
+    return 0;
+}
+
+void SetAllocationCounting(bool) {
+}
+} // namespace Benchmark
+#endif
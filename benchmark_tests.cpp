@@ -0,0 +1,118 @@
+#include "benchmark.h"
+#include "test_runner.h"
+
+namespace Benchmark {
+void TestMeasure() {
+    size_t calls = 0;
+    Result result = Measure("allocate", 1000, 2000, [&calls] {
+        std::vector<char> data(1000);
+        calls += data.size() / 1000;
+    }, 3);
+
+    ASSERT_EQUAL(result.name, "allocate");
+    ASSERT_EQUAL(result.size, 1000u);
+    //калибровочный вызов не входит в iterations
+    ASSERT_EQUAL(calls, result.iterations + 1);
+    ASSERT(result.p50_ns > 0);
+    ASSERT(result.p50_ns <= result.p90_ns && result.p90_ns <= result.p99_ns);
+    ASSERT(result.gflops > 0);
+
+#ifdef FFT_BENCHMARK
+    ASSERT(result.bytes_per_op >= 1000);
+    ASSERT(result.allocations_per_op >= 1);
+
+    //массивы и выровненные объекты тоже считаются
+    struct alignas(64) Aligned {
+      char data[64];
+    };
+    //указатели уходят в volatile, иначе компилятор выбросит пару new и delete
+    static void* volatile escape = nullptr;
+    Result arrays = Measure("arrays", 1, 0, [] {
+        char* bytes = new char[100];
+        escape = bytes;
+        delete[] bytes;
+        Aligned* single = new Aligned;
+        escape = single;
+        delete single;
+        Aligned* several = new Aligned[2];
+        escape = several;
+        delete[] several;
+    }, 3);
+    ASSERT(escape != nullptr);
+    ASSERT(arrays.allocations_per_op >= 3);
+    ASSERT(arrays.bytes_per_op >= 100 + 3 * sizeof(Aligned));
+
+    //вне Measure выделения не считаются
+    size_t count_before = GetAllocationCount();
+    std::vector<char> data(1000);
+    ASSERT_EQUAL(GetAllocationCount(), count_before);
+#else
+    //без FFT_BENCHMARK operator new стандартный и ничего не считает
+    ASSERT_EQUAL(result.allocations_per_op, 0.0);
+#endif
+
+    const char* arguments[] = {"--filter=FFT", "--samples=3", "--threshold=0.5"};
+    Options options = ParseOptions(3, const_cast<char**>(arguments));
+    ASSERT_EQUAL(options.filter, "FFT");
+    ASSERT_EQUAL(options.samples, 3u);
+    ASSERT_EQUAL(options.threshold, 0.5);
+
+    bool thrown = false;
+    try {
+        const char* wrong[] = {"--fast"};
+        ParseOptions(1, const_cast<char**>(wrong));
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+
+    //неверные числа - тоже std::runtime_error, а не std::invalid_argument
+    for (const char* wrong : {"--samples=many", "--threshold=", "--samples=99999999999999999999"}) {
+        thrown = false;
+        try {
+            ParseOptions(1, const_cast<char**>(&wrong));
+        } catch (std::runtime_error&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+
+    //недоступные baseline и json обнаруживаются до замеров
+    for (const char* wrong : {"--baseline=/nonexistent/baseline.json",
+                              "--json=/nonexistent/result.json"}) {
+        const char* main_arguments[] = {"--filter=nothing", wrong};
+        ASSERT_EQUAL(Main(2, const_cast<char**>(main_arguments)), 2);
+    }
+}
+
+void TestJson() {
+    Result first;
+    first.name = "FastFourierTransform<double>";
+    first.size = 1024;
+    first.iterations = 100;
+    first.p50_ns = 1500.5;
+    first.p90_ns = 1600;
+    first.p99_ns = 1700;
+    first.gflops = 2.25;
+    first.bytes_per_op = 32768;
+    first.allocations_per_op = 21;
+
+    Result second = first;
+    second.size = 4096;
+    second.p50_ns = 8000;
+
+    std::vector<Result> parsed = ParseJson(ToJson({first, second}));
+    ASSERT_EQUAL(parsed.size(), 2u);
+    ASSERT_EQUAL(parsed[0].name, first.name);
+    ASSERT_EQUAL(parsed[0].size, first.size);
+    ASSERT_EQUAL(parsed[0].p50_ns, first.p50_ns);
+    ASSERT_EQUAL(parsed[0].gflops, first.gflops);
+    ASSERT_EQUAL(parsed[1].allocations_per_op, second.allocations_per_op);
+
+    //вторая позиция замедлилась больше чем на 10%
+    Result slower = second;
+    slower.p50_ns = 9000;
+    ASSERT(FindRegressions({first, slower}, parsed, 0.1).size() == 1);
+    ASSERT(FindRegressions({first, slower}, parsed, 0.2).empty());
+}
+}
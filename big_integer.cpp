@@ -0,0 +1,450 @@
+#include "big_integer.h"
+#include "integer_multiplication.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+//короче - в столбик, длиннее - Карацуба
+const size_t kKaratsubaThreshold = 32;
+
+//длиннее - через FFT
+const size_t kFFTThreshold = 1024;
+
+//десятичные строки не длиннее разбираются напрямую
+const size_t kNaiveParseLength = 64;
+
+//числа не длиннее стольких цифр по 2^32 переводятся в десятичную запись делением
+const size_t kNaiveConvertLength = 32;
+
+const uint32_t kDecimalChunk = 1000000000;
+const size_t kDecimalChunkLength = 9;
+}
+
+BigInt::BigInt(int64_t value)
+    : negative_(value < 0) {
+    uint64_t magnitude = value < 0 ? ~static_cast<uint64_t>(value) + 1 : value;
+    while (magnitude > 0) {
+        digits_.push_back(static_cast<uint32_t>(magnitude));
+        magnitude >>= 32;
+    }
+}
+
+BigInt::BigInt(const std::string& decimal) {
+    size_t begin = 0;
+    if (!decimal.empty() && (decimal[0] == '-' || decimal[0] == '+')) {
+        begin = 1;
+    }
+    if (begin == decimal.size() ||
+        !std::all_of(begin + decimal.begin(), decimal.end(), [](char symbol) {
+            return '0' <= symbol && symbol <= '9';
+        })) {
+        std::ostringstream os;
+        os << "Exception thrown in BigInt, not a decimal number: " << decimal << "\n";
+        throw std::runtime_error(os.str());
+    }
+
+    //powers[j] = 10^(kNaiveParseLength * 2^j) для всех длин младших половин
+    std::vector<Digits> powers;
+    for (size_t length = kNaiveParseLength; length < decimal.size() - begin; length *= 2) {
+        if (powers.empty()) {
+            size_t half = kNaiveParseLength / 2;
+            Digits root = ParseMagnitude("1" + std::string(half, '0'), 0, half + 1, powers);
+            powers.push_back(MultiplyMagnitudes(root, root));
+        } else {
+            powers.push_back(MultiplyMagnitudes(powers.back(), powers.back()));
+        }
+    }
+
+    digits_ = ParseMagnitude(decimal, begin, decimal.size(), powers);
+    negative_ = decimal[0] == '-' && !digits_.empty();
+}
+
+BigInt::Digits BigInt::ParseMagnitude(const std::string& decimal, size_t begin, size_t end,
+                                     const std::vector<Digits>& powers) {
+    if (end - begin <= kNaiveParseLength) {
+        Digits result;
+        for (size_t chunk_begin = begin; chunk_begin < end; chunk_begin += kDecimalChunkLength) {
+            size_t chunk_end = std::min(end, chunk_begin + kDecimalChunkLength);
+            uint64_t multiplier = 1;
+            uint64_t carry = 0;
+            for (size_t i = chunk_begin; i < chunk_end; ++i) {
+                multiplier *= 10;
+                carry = carry * 10 + (decimal[i] - '0');
+            }
+            //result = result * 10^(длина куска) + кусок
+            for (auto& digit : result) {
+                uint64_t current = digit * multiplier + carry;
+                digit = static_cast<uint32_t>(current);
+                carry = current >> 32;
+            }
+            if (carry > 0) {
+                result.push_back(static_cast<uint32_t>(carry));
+            }
+        }
+        Trim(result);
+        return result;
+    }
+
+    //младшая половина - наибольшая степень двойки цифр, меньшая длины,
+    //тогда нужны только степени 10^(2^k), и они получаются возведением в квадрат
+    size_t low_length = kNaiveParseLength;
+    size_t level = 0;
+    while (2 * low_length < end - begin) {
+        low_length *= 2;
+        ++level;
+    }
+    size_t middle = end - low_length;
+
+    Digits result = MultiplyMagnitudes(ParseMagnitude(decimal, begin, middle, powers),
+                                       powers[level]);
+    return AddMagnitudes(result, ParseMagnitude(decimal, middle, end, powers));
+}
+
+BigInt::Digits BigInt::ConvertMagnitude(const Digits& digits, size_t begin, size_t end,
+                                        const std::vector<Digits>& powers) {
+    if (end - begin <= kNaiveConvertLength) {
+        //делим на 10^9, пока число не кончится, куски идут от младших к старшим
+        Digits magnitude(digits.begin() + begin, digits.begin() + end);
+        Trim(magnitude);
+        Digits chunks;
+        while (!magnitude.empty()) {
+            uint64_t remainder = 0;
+            for (size_t i = magnitude.size(); i > 0; --i) {
+                uint64_t current = (remainder << 32) | magnitude[i - 1];
+                magnitude[i - 1] = static_cast<uint32_t>(current / kDecimalChunk);
+                remainder = current % kDecimalChunk;
+            }
+            Trim(magnitude);
+            chunks.push_back(static_cast<uint32_t>(remainder));
+        }
+        return chunks;
+    }
+
+    //как в ParseMagnitude, младшая половина - наибольшая степень двойки цифр
+    size_t low_length = kNaiveConvertLength;
+    size_t level = 0;
+    while (2 * low_length < end - begin) {
+        low_length *= 2;
+        ++level;
+    }
+    size_t middle = begin + low_length;
+
+    Digits result = MultiplyDecimal(ConvertMagnitude(digits, middle, end, powers),
+                                    powers[level]);
+    return AddDecimal(result, ConvertMagnitude(digits, begin, middle, powers));
+}
+
+BigInt::Digits BigInt::AddDecimal(const Digits& first, const Digits& second) {
+    Digits result(std::max(first.size(), second.size()) + 1);
+    uint32_t carry = 0;
+    for (size_t i = 0; i < result.size(); ++i) {
+        uint32_t current = carry + (i < first.size() ? first[i] : 0) +
+                           (i < second.size() ? second[i] : 0);
+        carry = current >= kDecimalChunk ? 1 : 0;
+        result[i] = current - carry * kDecimalChunk;
+    }
+    Trim(result);
+    return result;
+}
+
+BigInt::Digits BigInt::MultiplyDecimal(const Digits& first, const Digits& second) {
+    if (first.empty() || second.empty()) {
+        return {};
+    }
+
+    //свертка кусков, коэффициенты меньше n * 10^18 и помещаются в 127 бит
+    std::vector<unsigned __int128> product(first.size() + second.size() - 1);
+    if (std::min(first.size(), second.size()) <= kKaratsubaThreshold) {
+        for (size_t i = 0; i < first.size(); ++i) {
+            for (size_t j = 0; j < second.size(); ++j) {
+                product[i + j] += static_cast<uint64_t>(first[i]) * second[j];
+            }
+        }
+    } else {
+        std::vector<__int128> exact = IntegerMultiplication::MultiplyExact(
+            std::vector<int64_t>(first.begin(), first.end()),
+            std::vector<int64_t>(second.begin(), second.end())
+        );
+        std::copy(exact.begin(), exact.begin() + product.size(), product.begin());
+    }
+
+    //перенос разрядов по основанию 10^9
+    Digits result;
+    result.reserve(product.size() + 2);
+    unsigned __int128 carry = 0;
+    for (size_t i = 0; i < product.size() || carry > 0; ++i) {
+        carry += i < product.size() ? product[i] : 0;
+        result.push_back(static_cast<uint32_t>(carry % kDecimalChunk));
+        carry /= kDecimalChunk;
+    }
+    Trim(result);
+    return result;
+}
+
+std::string BigInt::ToString() const {
+    if (digits_.empty()) {
+        return "0";
+    }
+
+    //powers[j] = (2^32)^(kNaiveConvertLength * 2^j) кусками по 10^9
+    std::vector<Digits> powers;
+    for (size_t length = kNaiveConvertLength; length < digits_.size(); length *= 2) {
+        if (powers.empty()) {
+            Digits root(kNaiveConvertLength / 2 + 1);
+            root.back() = 1;
+            Digits decimal_root = ConvertMagnitude(root, 0, root.size(), powers);
+            powers.push_back(MultiplyDecimal(decimal_root, decimal_root));
+        } else {
+            powers.push_back(MultiplyDecimal(powers.back(), powers.back()));
+        }
+    }
+    Digits chunks = ConvertMagnitude(digits_, 0, digits_.size(), powers);
+
+    std::ostringstream os;
+    if (negative_) {
+        os << '-';
+    }
+    os << chunks.back();
+    for (size_t i = chunks.size() - 1; i > 0; --i) {
+        os << std::setw(kDecimalChunkLength) << std::setfill('0') << chunks[i - 1];
+    }
+    return os.str();
+}
+
+void BigInt::Trim(Digits& digits) {
+    while (!digits.empty() && digits.back() == 0) {
+        digits.pop_back();
+    }
+}
+
+int BigInt::CompareMagnitudes(const Digits& first, const Digits& second) {
+    if (first.size() != second.size()) {
+        return first.size() < second.size() ? -1 : 1;
+    }
+    for (size_t i = first.size(); i > 0; --i) {
+        if (first[i - 1] != second[i - 1]) {
+            return first[i - 1] < second[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+BigInt::Digits BigInt::AddMagnitudes(const Digits& first, const Digits& second) {
+    const Digits& longer = first.size() >= second.size() ? first : second;
+    const Digits& shorter = first.size() >= second.size() ? second : first;
+
+    Digits result(longer.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < longer.size(); ++i) {
+        uint64_t current = carry + longer[i] + (i < shorter.size() ? shorter[i] : 0);
+        result[i] = static_cast<uint32_t>(current);
+        carry = current >> 32;
+    }
+    result.back() = static_cast<uint32_t>(carry);
+    Trim(result);
+    return result;
+}
+
+BigInt::Digits BigInt::SubtractMagnitudes(const Digits& first, const Digits& second) {
+    Digits result(first.size());
+    int64_t borrow = 0;
+    for (size_t i = 0; i < first.size(); ++i) {
+        int64_t current = static_cast<int64_t>(first[i]) - borrow -
+                          (i < second.size() ? second[i] : 0);
+        borrow = current < 0 ? 1 : 0;
+        result[i] = static_cast<uint32_t>(current + (borrow << 32));
+    }
+    Trim(result);
+    return result;
+}
+
+BigInt::Digits BigInt::MultiplyMagnitudes(const Digits& first, const Digits& second) {
+    if (first.empty() || second.empty()) {
+        return {};
+    }
+    size_t shorter = std::min(first.size(), second.size());
+    if (shorter <= kKaratsubaThreshold) {
+        return MultiplySchoolbook(first, second);
+    }
+    if (shorter <= kFFTThreshold) {
+        return MultiplyKaratsuba(first, second);
+    }
+    return MultiplyFFT(first, second);
+}
+
+BigInt::Digits BigInt::MultiplySchoolbook(const Digits& first, const Digits& second) {
+    Digits result(first.size() + second.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < second.size(); ++j) {
+            uint64_t current = static_cast<uint64_t>(first[i]) * second[j] + result[i + j] + carry;
+            result[i + j] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        result[i + second.size()] = static_cast<uint32_t>(carry);
+    }
+    Trim(result);
+    return result;
+}
+
+BigInt::Digits BigInt::MultiplyKaratsuba(const Digits& first, const Digits& second) {
+    //a = a1 * B^half + a0, b = b1 * B^half + b0,
+    //a * b = z2 * B^(2 half) + z1 * B^half + z0, z1 = (a0 + a1)(b0 + b1) - z0 - z2
+    size_t half = std::max(first.size(), second.size()) / 2;
+
+    auto split = [half](const Digits& digits, Digits& low, Digits& high) {
+        size_t bound = std::min(half, digits.size());
+        low.assign(digits.begin(), digits.begin() + bound);
+        high.assign(digits.begin() + bound, digits.end());
+        Trim(low);
+    };
+
+    Digits first_low, first_high, second_low, second_high;
+    split(first, first_low, first_high);
+    split(second, second_low, second_high);
+
+    Digits low = MultiplyMagnitudes(first_low, second_low);
+    Digits high = MultiplyMagnitudes(first_high, second_high);
+    Digits middle = MultiplyMagnitudes(AddMagnitudes(first_low, first_high),
+                                       AddMagnitudes(second_low, second_high));
+    middle = SubtractMagnitudes(SubtractMagnitudes(middle, low), high);
+
+    Digits result(first.size() + second.size() + 1);
+    auto add_shifted = [&result](const Digits& digits, size_t shift) {
+        uint64_t carry = 0;
+        size_t i = 0;
+        for (; i < digits.size(); ++i) {
+            uint64_t current = static_cast<uint64_t>(result[i + shift]) + digits[i] + carry;
+            result[i + shift] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        for (; carry > 0; ++i) {
+            uint64_t current = static_cast<uint64_t>(result[i + shift]) + carry;
+            result[i + shift] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+    };
+    add_shifted(low, 0);
+    add_shifted(middle, half);
+    add_shifted(high, 2 * half);
+
+    Trim(result);
+    return result;
+}
+
+BigInt::Digits BigInt::MultiplyFFT(const Digits& first, const Digits& second) {
+    //цифры по основанию 2^16 - коэффициенты многочленов, значение числа - многочлен в точке 2^16
+    auto to_polynomial = [](const Digits& digits) {
+        std::vector<int64_t> coefficients(2 * digits.size());
+        for (size_t i = 0; i < digits.size(); ++i) {
+            coefficients[2 * i] = digits[i] & 0xFFFF;
+            coefficients[2 * i + 1] = digits[i] >> 16;
+        }
+        return coefficients;
+    };
+
+    std::vector<__int128> product = IntegerMultiplication::MultiplyExact(
+        to_polynomial(first), to_polynomial(second)
+    );
+
+    //перенос разрядов: все коэффициенты неотрицательны
+    std::vector<uint32_t> halves(product.size() + 8);
+    unsigned __int128 carry = 0;
+    for (size_t i = 0; i < halves.size(); ++i) {
+        carry += i < product.size() ? static_cast<unsigned __int128>(product[i]) : 0;
+        halves[i] = static_cast<uint32_t>(carry & 0xFFFF);
+        carry >>= 16;
+    }
+
+    Digits result((halves.size() + 1) / 2);
+    for (size_t i = 0; i < halves.size(); ++i) {
+        result[i / 2] |= halves[i] << (16 * (i % 2));
+    }
+    Trim(result);
+    return result;
+}
+
+bool BigInt::operator==(const BigInt& other) const {
+    return negative_ == other.negative_ && digits_ == other.digits_;
+}
+
+bool BigInt::operator!=(const BigInt& other) const {
+    return !(*this == other);
+}
+
+bool BigInt::operator<(const BigInt& other) const {
+    if (negative_ != other.negative_) {
+        return negative_;
+    }
+    int comparison = CompareMagnitudes(digits_, other.digits_);
+    return negative_ ? comparison > 0 : comparison < 0;
+}
+
+bool BigInt::operator>(const BigInt& other) const {
+    return other < *this;
+}
+
+bool BigInt::operator<=(const BigInt& other) const {
+    return !(other < *this);
+}
+
+bool BigInt::operator>=(const BigInt& other) const {
+    return !(*this < other);
+}
+
+BigInt& BigInt::operator+=(const BigInt& other) {
+    if (negative_ == other.negative_) {
+        digits_ = AddMagnitudes(digits_, other.digits_);
+        return *this;
+    }
+
+    //знаки разные - вычитаем из большего по модулю меньшее
+    if (CompareMagnitudes(digits_, other.digits_) >= 0) {
+        digits_ = SubtractMagnitudes(digits_, other.digits_);
+    } else {
+        digits_ = SubtractMagnitudes(other.digits_, digits_);
+        negative_ = other.negative_;
+    }
+    if (digits_.empty()) {
+        negative_ = false;
+    }
+    return *this;
+}
+
+BigInt& BigInt::operator-=(const BigInt& other) {
+    return *this += -other;
+}
+
+BigInt& BigInt::operator*=(const BigInt& other) {
+    digits_ = MultiplyMagnitudes(digits_, other.digits_);
+    negative_ = !digits_.empty() && negative_ != other.negative_;
+    return *this;
+}
+
+const BigInt BigInt::operator+(const BigInt& other) const {
+    BigInt result = *this;
+    return result += other;
+}
+
+const BigInt BigInt::operator-(const BigInt& other) const {
+    BigInt result = *this;
+    return result -= other;
+}
+
+const BigInt BigInt::operator*(const BigInt& other) const {
+    BigInt result = *this;
+    return result *= other;
+}
+
+const BigInt BigInt::operator-() const {
+    BigInt result = *this;
+    result.negative_ = !result.digits_.empty() && !negative_;
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& ostr, const BigInt& value) {
+    return ostr << value.ToString();
+}
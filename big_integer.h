@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Целые числа произвольной длины. Модуль хранится цифрами по основанию 2^32,
+// умножение выбирается по длине: в столбик, Карацуба, а для длинных чисел
+// цифры режутся на 16-битные и перемножаются как многочлены через точное FFT
+// из integer_multiplication.h с последующим переносом разрядов
+class BigInt {
+ public:
+  BigInt() = default;
+
+  BigInt(int64_t value);
+
+  // Десятичная запись, возможно со знаком минус
+  explicit BigInt(const std::string& decimal);
+
+  std::string ToString() const;
+
+  bool IsNegative() const {
+      return negative_;
+  }
+
+  bool operator==(const BigInt& other) const;
+
+  bool operator!=(const BigInt& other) const;
+
+  bool operator<(const BigInt& other) const;
+
+  bool operator>(const BigInt& other) const;
+
+  bool operator<=(const BigInt& other) const;
+
+  bool operator>=(const BigInt& other) const;
+
+  BigInt& operator+=(const BigInt& other);
+
+  BigInt& operator-=(const BigInt& other);
+
+  BigInt& operator*=(const BigInt& other);
+
+  const BigInt operator+(const BigInt& other) const;
+
+  const BigInt operator-(const BigInt& other) const;
+
+  const BigInt operator*(const BigInt& other) const;
+
+  const BigInt operator-() const;
+
+  friend std::ostream& operator<<(std::ostream& ostr, const BigInt& value);
+
+ private:
+  using Digits = std::vector<uint32_t>;
+
+  static int CompareMagnitudes(const Digits& first, const Digits& second);
+
+  static Digits AddMagnitudes(const Digits& first, const Digits& second);
+
+  // first >= second
+  static Digits SubtractMagnitudes(const Digits& first, const Digits& second);
+
+  static Digits MultiplyMagnitudes(const Digits& first, const Digits& second);
+
+  static Digits MultiplySchoolbook(const Digits& first, const Digits& second);
+
+  static Digits MultiplyKaratsuba(const Digits& first, const Digits& second);
+
+  static Digits MultiplyFFT(const Digits& first, const Digits& second);
+
+  static void Trim(Digits& digits);
+
+  // Разбор десятичной записи без знака делением пополам: старшая половина
+  // умножается на powers[j] = 10^(kNaiveParseLength * 2^j), степени считаются
+  // один раз на все узлы
+  static Digits ParseMagnitude(const std::string& decimal, size_t begin, size_t end,
+                               const std::vector<Digits>& powers);
+
+  // Обратный перевод цифр [begin, end) в куски по 10^9 от младших к старшим так же
+  // делением пополам: старшая половина умножается на
+  // powers[j] = (2^32)^(kNaiveConvertLength * 2^j), записанное кусками по 10^9
+  static Digits ConvertMagnitude(const Digits& digits, size_t begin, size_t end,
+                                 const std::vector<Digits>& powers);
+
+  // Сложение и умножение чисел, записанных кусками по 10^9
+  static Digits AddDecimal(const Digits& first, const Digits& second);
+
+  static Digits MultiplyDecimal(const Digits& first, const Digits& second);
+
+  Digits digits_;
+  bool negative_ = false;
+};
+
+//Тесты
+namespace BigIntTests {
+void Conversion();
+void AddAndSubtract();
+void Multiply();
+} // namespace BigIntTests
@@ -0,0 +1,78 @@
+#include "big_integer.h"
+#include "test_runner.h"
+
+namespace BigIntTests {
+void Conversion() {
+    ASSERT_EQUAL(BigInt().ToString(), "0");
+    ASSERT_EQUAL(BigInt(-1234567890123456789LL).ToString(), "-1234567890123456789");
+    ASSERT_EQUAL(BigInt(INT64_MIN).ToString(), "-9223372036854775808");
+    ASSERT_EQUAL(BigInt("-0"), BigInt(0));
+
+    //длинные строки разбираются делением пополам
+    std::string decimal = "9";
+    for (size_t i = 0; i < 500; ++i) {
+        decimal += static_cast<char>('0' + (i * 7) % 10);
+    }
+    ASSERT_EQUAL(BigInt(decimal).ToString(), decimal);
+    ASSERT_EQUAL(BigInt("-" + decimal).ToString(), "-" + decimal);
+
+    //длинные числа переводятся в строку тоже делением пополам: 10^4096 получено
+    //возведением в квадрат, без разбора строки
+    BigInt power(10);
+    for (size_t i = 0; i < 12; ++i) {
+        power *= power;
+    }
+    ASSERT_EQUAL(power.ToString(), "1" + std::string(4096, '0'));
+    ASSERT_EQUAL((power - 1).ToString(), std::string(4096, '9'));
+
+    std::string long_decimal;
+    for (size_t i = 0; i < 100000; ++i) {
+        long_decimal += static_cast<char>('1' + (i * i + i / 7) % 9);
+    }
+    ASSERT_EQUAL(BigInt(long_decimal).ToString(), long_decimal);
+
+    bool thrown = false;
+    try {
+        BigInt("12a3");
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+
+void AddAndSubtract() {
+    BigInt a("123456789012345678901234567890"), b("987654321098765432109876543210");
+
+    ASSERT_EQUAL((a + b).ToString(), "1111111110111111111011111111100");
+    ASSERT_EQUAL((a - b).ToString(), "-864197532086419753208641975320");
+    ASSERT_EQUAL((b - a) + (a - b), BigInt(0));
+    ASSERT_EQUAL(-a + a, BigInt(0));
+    ASSERT(a < b);
+    ASSERT(-b < -a);
+    ASSERT(BigInt(-1) < BigInt(0));
+    ASSERT(a >= a);
+
+    BigInt c = BigInt(UINT32_MAX) + BigInt(1);
+    ASSERT_EQUAL(c.ToString(), "4294967296");
+}
+
+void Multiply() {
+    ASSERT_EQUAL((BigInt(-123456789) * BigInt(987654321)).ToString(), "-121932631112635269");
+    ASSERT_EQUAL(BigInt(0) * BigInt(-5), BigInt(0));
+
+    //(10^k - 1)^2 = 10^(2k) - 2 * 10^k + 1, при разных k работают все три алгоритма
+    for (size_t k : {50, 2000, 30000}) {
+        BigInt nines(std::string(k, '9'));
+        std::string expected = std::string(k - 1, '9') + "8" + std::string(k - 1, '0') + "1";
+        ASSERT_EQUAL((nines * nines).ToString(), expected);
+    }
+
+    //(x + 1)(x - 1) = x^2 - 1
+    std::string decimal;
+    for (size_t i = 0; i < 20000; ++i) {
+        decimal += static_cast<char>('1' + (i * 13) % 9);
+    }
+    BigInt x(decimal);
+    ASSERT_EQUAL((x + 1) * (x - 1), x * x - 1);
+}
+} // namespace BigIntTests
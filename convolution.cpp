@@ -0,0 +1,177 @@
+#include "convolution.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+//если ядро или сигнал не длиннее, то свертка считается напрямую за O(n * m)
+const size_t kDirectConvolutionSize = 32;
+
+//автоматическая длина блока: около 8 длин ядра, но не меньше kMinBlockLength
+//и так, чтобы рабочий массив не превышал kBlockBytes
+const size_t kMinBlockLength = 1024;
+const size_t kBlockBytes = size_t(1) << 18;
+
+size_t RoundUpToPowerOfTwo(size_t degree) {
+    size_t length = 1;
+    while (length < degree) {
+        length *= 2;
+    }
+    return length;
+}
+
+template <typename T>
+size_t ChooseBlockLength(size_t kernel_size, size_t block_length) {
+    if (kernel_size == 0) {
+        std::ostringstream os;
+        os << "Exception thrown in Convolver, kernel is empty\n";
+        throw std::runtime_error(os.str());
+    }
+
+    size_t length = RoundUpToPowerOfTwo(std::max(block_length, 2 * kernel_size));
+    if (block_length == 0) {
+        size_t target = std::max(8 * kernel_size, kMinBlockLength);
+        while (length < target && 2 * length * sizeof(T) <= kBlockBytes) {
+            length *= 2;
+        }
+    }
+    return length;
+}
+}
+
+template <typename T>
+Convolver<T>::Convolver(const std::vector<T>& kernel, size_t block_length)
+    : kernel_(kernel),
+      reversed_kernel_(kernel.rbegin(), kernel.rend()),
+      plan_(ChooseBlockLength<T>(kernel.size(), block_length)),
+      spectrum_(plan_.GetDegree()),
+      reversed_spectrum_(plan_.GetDegree()) {
+    for (auto& elem : reversed_kernel_) {
+        elem = std::conj(elem);
+    }
+
+    std::copy(kernel_.begin(), kernel_.end(), spectrum_.begin());
+    plan_.Forward(spectrum_.data());
+    std::copy(reversed_kernel_.begin(), reversed_kernel_.end(), reversed_spectrum_.begin());
+    plan_.Forward(reversed_spectrum_.data());
+}
+
+template <typename T>
+void Convolver<T>::ConvolveBlock(const T* block, size_t size, const std::vector<T>& spectrum,
+                                 std::vector<T>& work, T* output) const {
+    std::fill(std::copy(block, block + size, work.begin()), work.end(), T(0));
+    plan_.Forward(work.data());
+    for (size_t i = 0; i < work.size(); ++i) {
+        work[i] *= spectrum[i];
+    }
+    plan_.Inverse(work.data());
+    for (size_t i = 0; i < size + kernel_.size() - 1; ++i) {
+        output[i] += work[i];
+    }
+}
+
+template <typename T>
+std::vector<T> Convolver<T>::ConvolveWith(const std::vector<T>& signal,
+                                          const std::vector<T>& kernel,
+                                          const std::vector<T>& spectrum) const {
+    if (signal.empty()) {
+        return {};
+    }
+
+    std::vector<T> result(signal.size() + kernel.size() - 1);
+    if (std::min(signal.size(), kernel.size()) <= kDirectConvolutionSize) {
+        for (size_t i = 0; i < signal.size(); ++i) {
+            for (size_t j = 0; j < kernel.size(); ++j) {
+                result[i + j] += signal[i] * kernel[j];
+            }
+        }
+        return result;
+    }
+
+    //overlap-add: результаты соседних блоков перекрываются на kernel.size() - 1
+    size_t step = GetBlockLength() - kernel.size() + 1;
+    std::vector<T> work(GetBlockLength());
+    for (size_t begin = 0; begin < signal.size(); begin += step) {
+        size_t size = std::min(step, signal.size() - begin);
+        ConvolveBlock(signal.data() + begin, size, spectrum, work, result.data() + begin);
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<T> Convolver<T>::Convolve(const std::vector<T>& signal) const {
+    return ConvolveWith(signal, kernel_, spectrum_);
+}
+
+template <typename T>
+std::vector<T> Convolver<T>::ConvolveCircular(const std::vector<T>& signal) const {
+    std::vector<T> linear = Convolve(signal);
+    std::vector<T> result(signal.size());
+    for (size_t i = 0; i < linear.size(); ++i) {
+        result[i % signal.size()] += linear[i];
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<T> Convolver<T>::Correlate(const std::vector<T>& signal) const {
+    if (signal.size() < kernel_.size()) {
+        return {};
+    }
+    //свертка с развернутым сопряженным ядром в позиции i + kernel.size() - 1
+    //равна корреляции в позиции i
+    std::vector<T> full = ConvolveWith(signal, reversed_kernel_, reversed_spectrum_);
+    return std::vector<T>(full.begin() + kernel_.size() - 1, full.begin() + signal.size());
+}
+
+template <typename T>
+std::vector<T> Convolver<T>::Push(const std::vector<T>& chunk) {
+    pending_.insert(pending_.end(), chunk.begin(), chunk.end());
+
+    size_t step = GetBlockLength() - kernel_.size() + 1;
+    if (pending_.size() < step) {
+        return {};
+    }
+    if (overlap_.empty()) {
+        overlap_.assign(kernel_.size() - 1, T(0));
+        work_.resize(GetBlockLength());
+    }
+
+    //готовы первые step отсчетов каждого полного блока,
+    //остальные kernel.size() - 1 переходят в перекрытие со следующим
+    size_t blocks = pending_.size() / step;
+    std::vector<T> result(blocks * step + kernel_.size() - 1);
+    std::copy(overlap_.begin(), overlap_.end(), result.begin());
+    for (size_t block = 0; block < blocks; ++block) {
+        ConvolveBlock(pending_.data() + block * step, step, spectrum_, work_,
+                      result.data() + block * step);
+    }
+
+    std::copy(result.begin() + blocks * step, result.end(), overlap_.begin());
+    result.resize(blocks * step);
+    pending_.erase(pending_.begin(), pending_.begin() + blocks * step);
+    return result;
+}
+
+template <typename T>
+std::vector<T> Convolver<T>::Flush() {
+    if (pending_.empty() && overlap_.empty()) {
+        return {};
+    }
+
+    std::vector<T> result(pending_.size() + kernel_.size() - 1);
+    std::copy(overlap_.begin(), overlap_.end(), result.begin());
+    if (!pending_.empty()) {
+        work_.resize(GetBlockLength());
+        ConvolveBlock(pending_.data(), pending_.size(), spectrum_, work_, result.data());
+    }
+
+    pending_.clear();
+    overlap_.clear();
+    return result;
+}
+
+template class Convolver<std::complex<float>>;
+template class Convolver<std::complex<double>>;
+template class Convolver<std::complex<long double>>;
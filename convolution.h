@@ -0,0 +1,77 @@
+#pragma once
+
+#include <complex>
+#include <cstdlib>
+#include <vector>
+
+#include "fft.h"
+
+// Свертка сигналов с фиксированным ядром. Спектр ядра вычисляется один раз в
+// конструкторе. Короткие ядра и сигналы сворачиваются напрямую, длинные -
+// методом overlap-add: сигнал режется на блоки длины block_length - kernel.size() + 1,
+// каждый блок сворачивается через FFT длины block_length, хвосты блоков складываются.
+// Длина блока по умолчанию - несколько длин ядра, чтобы блок помещался в кэш
+template <typename T>
+class Convolver {
+ public:
+  // block_length - длина FFT для одного блока, округляется вверх до степени двойки,
+  // не меньшей 2 * kernel.size(); 0 - выбрать автоматически
+  explicit Convolver(const std::vector<T>& kernel, size_t block_length = 0);
+
+  const std::vector<T>& GetKernel() const {
+      return kernel_;
+  }
+
+  size_t GetBlockLength() const {
+      return plan_.GetDegree();
+  }
+
+  // Линейная свертка: result[i] = sum_j kernel[j] * signal[i - j], длина
+  // signal.size() + kernel.size() - 1
+  std::vector<T> Convolve(const std::vector<T>& signal) const;
+
+  // Циклическая свертка длины signal.size(): индексы signal берутся по модулю его длины
+  std::vector<T> ConvolveCircular(const std::vector<T>& signal) const;
+
+  // Взаимная корреляция по позициям, где ядро целиком лежит в сигнале:
+  // result[i] = sum_j signal[i + j] * conj(kernel[j]), длина signal.size() - kernel.size() + 1
+  std::vector<T> Correlate(const std::vector<T>& signal) const;
+
+  // Потоковая линейная свертка: очередной кусок сигнала произвольной длины,
+  // возвращает следующие готовые отсчеты результата
+  std::vector<T> Push(const std::vector<T>& chunk);
+
+  // Завершает поток: возвращает оставшиеся отсчеты, включая хвост длины
+  // kernel.size() - 1, и готовит объект к новому потоку
+  std::vector<T> Flush();
+
+ private:
+  // Свертка с ядром kernel (его спектр - spectrum) целиком, напрямую или блоками
+  std::vector<T> ConvolveWith(const std::vector<T>& signal, const std::vector<T>& kernel,
+                              const std::vector<T>& spectrum) const;
+
+  // Сворачивает блок block длины не больше GetBlockLength() - kernel_.size() + 1
+  // и прибавляет результат к output, начиная с output[0]; work - рабочий массив
+  // длины GetBlockLength()
+  void ConvolveBlock(const T* block, size_t size, const std::vector<T>& spectrum,
+                     std::vector<T>& work, T* output) const;
+
+  std::vector<T> kernel_;
+  // Развернутое и сопряженное ядро для корреляции
+  std::vector<T> reversed_kernel_;
+  FFT::Plan<T> plan_;
+  std::vector<T> spectrum_;
+  std::vector<T> reversed_spectrum_;
+
+  // Состояние потока: накопленный неполный блок и перекрытие с прошлым блоком
+  std::vector<T> pending_;
+  std::vector<T> overlap_;
+  std::vector<T> work_;
+};
+
+//Тесты для Convolver
+namespace ConvolutionTests {
+void Linear();
+void CircularAndCorrelation();
+void Streaming();
+} // namespace ConvolutionTests
@@ -0,0 +1,110 @@
+#include "convolution.h"
+#include "test_runner.h"
+
+namespace ConvolutionTests {
+namespace {
+//свертка по определению для проверки
+std::vector<std::complex<double>> NaiveConvolution(const std::vector<std::complex<double>>& first,
+                                                   const std::vector<std::complex<double>>& second) {
+    std::vector<std::complex<double>> result(first.size() + second.size() - 1);
+    for (size_t i = 0; i < first.size(); ++i) {
+        for (size_t j = 0; j < second.size(); ++j) {
+            result[i + j] += first[i] * second[j];
+        }
+    }
+    return result;
+}
+
+std::vector<std::complex<double>> MakeSignal(size_t size, size_t seed) {
+    std::vector<std::complex<double>> result(size);
+    for (size_t i = 0; i < size; ++i) {
+        result[i] = std::complex<double>((i * seed) % 17, (i + seed) % 5) - 4.0;
+    }
+    return result;
+}
+}
+
+void Linear() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-8;
+
+    Convolver<complex<double>> small({1, 2, 3});
+    ASSERT_VECTOR(small.Convolve({1, 1}), vector<complex<double>>({1, 3, 5, 3}), error);
+    ASSERT(small.Convolve({}).empty());
+
+    //ядро длиннее порога прямой свертки, сигнал - на много блоков
+    vector<complex<double>> kernel = MakeSignal(100, 3), signal = MakeSignal(3000, 7);
+    Convolver<complex<double>> convolver(kernel);
+    ASSERT(convolver.GetBlockLength() >= 2 * kernel.size());
+    ASSERT_VECTOR(convolver.Convolve(signal), NaiveConvolution(signal, kernel), error);
+
+    //явно заданная длина блока
+    Convolver<complex<double>> blocked(kernel, 256);
+    ASSERT_EQUAL(blocked.GetBlockLength(), 256u);
+    ASSERT_VECTOR(blocked.Convolve(signal), NaiveConvolution(signal, kernel), error);
+
+    bool thrown = false;
+    try {
+        Convolver<complex<float>> empty({});
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+
+void CircularAndCorrelation() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-8;
+
+    Convolver<complex<double>> shift({0, 1});
+    ASSERT_VECTOR(shift.ConvolveCircular({1, 2, 3, 4}),
+                  vector<complex<double>>({4, 1, 2, 3}), error);
+
+    vector<complex<double>> kernel = MakeSignal(40, 5), signal = MakeSignal(500, 11);
+    Convolver<complex<double>> convolver(kernel);
+
+    vector<complex<double>> expected(signal.size() - kernel.size() + 1);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        for (size_t j = 0; j < kernel.size(); ++j) {
+            expected[i] += signal[i + j] * std::conj(kernel[j]);
+        }
+    }
+    ASSERT_VECTOR(convolver.Correlate(signal), expected, error);
+    ASSERT(convolver.Correlate(vector<complex<double>>(10)).empty());
+}
+
+void Streaming() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-8;
+
+    vector<complex<double>> kernel = MakeSignal(50, 2), signal = MakeSignal(2500, 13);
+    Convolver<complex<double>> convolver(kernel, 128);
+
+    //куски разной длины, в том числе меньше блока
+    vector<complex<double>> result;
+    size_t chunk = 1;
+    for (size_t begin = 0; begin < signal.size(); begin += chunk) {
+        chunk = chunk * 3 % 401;
+        size_t end = std::min(signal.size(), begin + chunk);
+        vector<complex<double>> output =
+            convolver.Push({signal.begin() + begin, signal.begin() + end});
+        result.insert(result.end(), output.begin(), output.end());
+    }
+    vector<complex<double>> tail = convolver.Flush();
+    result.insert(result.end(), tail.begin(), tail.end());
+    ASSERT_VECTOR(result, NaiveConvolution(signal, kernel), error);
+
+    //после Flush объект готов к новому потоку
+    ASSERT(convolver.Flush().empty());
+    vector<complex<double>> again = convolver.Push({1});
+    tail = convolver.Flush();
+    again.insert(again.end(), tail.begin(), tail.end());
+    ASSERT_VECTOR(again, kernel, error);
+}
+} // namespace ConvolutionTests
@@ -1,10 +1,12 @@
 #include "fft.h"
+#include "fft_fixed.h"
+#include "instrumentation.h"
 
 namespace FFT {
     template <typename T>
     T GetRoot(size_t degree) {
-        static const typename T::value_type dPI = 2 * acos(-1);
-        return {cos(dPI / degree), sin(dPI / degree)};
+        static const typename T::value_type dPI = 2 * std::acos(typename T::value_type(-1));
+        return {std::cos(dPI / degree), std::sin(dPI / degree)};
     }
 
     template <typename T>
@@ -80,49 +82,104 @@ namespace FFT {
             throw std::runtime_error(os.str());
         }
 
+        INSTRUMENT_ALLOCATION(T, expected_length);
         std::vector<T> result = data;
         result.resize(expected_length, T(0));
         return result;
     }
 
     template <typename T>
-    std::vector<T> FastFourierTransform(const std::vector<T>& data) {
-        size_t degree = data.size();
-        if (degree == 1) {
-            return data;
-        }
-        //проверка на степень двойки
-        if (degree == 0 || ((degree & (degree - 1)) != 0)) {
-            std::ostringstream os;
-            os << "Exception thrown in FastFourierTransform,"
-                  " expected degree is not the power of two: "
-                << degree << "\n";
-            throw std::runtime_error(os.str());
+    struct RootTable {
+      const T* roots;
+      size_t stride;
+    };
+
+    //корни из 1 для рекурсивного преобразования длины degree: roots[i * stride] =
+    //GetRoot(degree)^i. Каждый корень считается отдельно, как в Plan, а не
+    //домножением на GetRoot(degree), иначе ошибка i-го корня растет как i * eps
+    //и оценка Accuracy::ConvolutionErrorBound перестает выполняться.
+    //Таблица одна на поток и строится для наибольшей запрошенной длины,
+    //корни меньших длин - ее прореживание
+    template <typename T>
+    RootTable<T> GetRoots(size_t degree) {
+        thread_local std::vector<T> roots;
+        if (roots.size() < degree / 2) {
+            static const typename T::value_type dPI = 2 * std::acos(typename T::value_type(-1));
+            INSTRUMENT_ALLOCATION(T, degree / 2);
+            roots.resize(degree / 2);
+            for (size_t i = 0; i < degree / 2; ++i) {
+                typename T::value_type angle = dPI * i / degree;
+                roots[i] = T(std::cos(angle), std::sin(angle));
+            }
         }
+        return {roots.data(), 2 * roots.size() / degree};
+    }
 
-        T root = GetRoot<T>(degree);
-        T curr_root = 1;
+    template <typename T>
+    std::vector<T> RecursiveTransform(const std::vector<T>& data, RootTable<T> table,
+                                      bool inverse) {
+        size_t degree = data.size();
+        //короткие векторы преобразуем развернутыми при компиляции кодлетами
+        if (degree <= kFixedMaxDegree) {
+            INSTRUMENT_ALLOCATION(T, degree);
+            std::vector<T> result(degree);
+            FixedTransform(data.data(), result.data(), degree, inverse);
+            return result;
+        }
 
+        INSTRUMENT_ALLOCATION(T, 2 * degree);
         std::vector<T> even_coef(degree / 2), odd_coef(degree / 2);
         for (size_t i = 0; i < degree / 2; ++i) {
             even_coef[i] += data[2 * i];
             odd_coef[i] += data[2 * i + 1];
         }
 
-        std::vector<T> even_data = FastFourierTransform(even_coef);
-        std::vector<T> odd_data = FastFourierTransform(odd_coef);
+        //у половинной длины корни - каждый второй из корней текущей
+        RootTable<T> half_table = {table.roots, 2 * table.stride};
+        std::vector<T> even_data = RecursiveTransform(even_coef, half_table, inverse);
+        std::vector<T> odd_data = RecursiveTransform(odd_coef, half_table, inverse);
 
         std::vector<T> result(degree);
 
         for (size_t i = 0; i < degree / 2; ++i) {
-            result[i] += even_data[i] + curr_root * odd_data[i];
-            result[i + degree / 2] +=  even_data[i] - curr_root * odd_data[i];
-            curr_root *= root;
+            T root = inverse ? std::conj(table.roots[i * table.stride])
+                             : table.roots[i * table.stride];
+            result[i] += even_data[i] + root * odd_data[i];
+            result[i + degree / 2] +=  even_data[i] - root * odd_data[i];
+            if (inverse) {
+                //делим на два на каждом уровне рекурсии, а кодлет в основании
+                //делит на свою длину, в итоге получается деление на n
+                result[i] /= T(2);
+                result[i + degree / 2] /= T(2);
+            }
         }
 
         return result;
     }
 
+    template <typename T>
+    std::vector<T> FastFourierTransform(const std::vector<T>& data) {
+        size_t degree = data.size();
+        if (degree == 1) {
+            return data;
+        }
+        //проверка на степень двойки
+        if (degree == 0 || ((degree & (degree - 1)) != 0)) {
+            std::ostringstream os;
+            os << "Exception thrown in FastFourierTransform,"
+                  " expected degree is not the power of two: "
+                << degree << "\n";
+            throw std::runtime_error(os.str());
+        }
+        INSTRUMENT_SCOPE("FastFourierTransform", T, degree);
+        //большие векторы не помещаются в кэш, для них
+        //переходим на шестишаговый алгоритм
+        if (degree >= kSixStepThreshold<T>) {
+            return SixStepFourierTransform(data);
+        }
+        return RecursiveTransform(data, GetRoots<T>(degree), false);
+    }
+
     template <typename T>
     std::vector<T> FastInverseFourierTransform(const std::vector<T>& data) {
         size_t degree = data.size();
@@ -138,33 +195,277 @@ namespace FFT {
             throw std::runtime_error(os.str());
         }
 
-        T inv_root = std::conj(GetRoot<T>(degree)) / std::norm(GetRoot<T>(degree));
-        T curr_inv_root = 1;
+        INSTRUMENT_SCOPE("FastInverseFourierTransform", T, degree);
+        if (degree >= kSixStepThreshold<T>) {
+            return SixStepInverseFourierTransform(data);
+        }
+        return RecursiveTransform(data, GetRoots<T>(degree), true);
+    }
 
-        std::vector<T> even_coef(degree / 2), odd_coef(degree / 2);
-        for (size_t i = 0; i < degree / 2; ++i) {
-            even_coef[i] += data[2 * i];
-            odd_coef[i] += data[2 * i + 1];
+    template <typename T>
+    void Transpose(const T* src, T* dst, size_t rows, size_t cols) {
+        //транспонируем квадратными блоками, чтобы и чтение,
+        //и запись шли по нескольким строкам кэша одновременно
+        const size_t block = 32;
+
+        for (size_t row_begin = 0; row_begin < rows; row_begin += block) {
+            size_t row_end = std::min(rows, row_begin + block);
+            for (size_t col_begin = 0; col_begin < cols; col_begin += block) {
+                size_t col_end = std::min(cols, col_begin + block);
+                for (size_t row = row_begin; row < row_end; ++row) {
+                    for (size_t col = col_begin; col < col_end; ++col) {
+                        dst[col * rows + row] = src[row * cols + col];
+                    }
+                }
+            }
         }
+    }
 
-        std::vector<T> even_data = FastInverseFourierTransform(even_coef);
-        std::vector<T> odd_data = FastInverseFourierTransform(odd_coef);
+    template <typename T>
+    void SixStepTransform(T* data, T* buffer, size_t degree, bool inverse,
+                          void (*transpose)(const T*, T*, size_t, size_t)) {
+        //проверка на степень двойки
+        if (degree == 0 || ((degree & (degree - 1)) != 0)) {
+            std::ostringstream os;
+            os << "Exception thrown in SixStepTransform,"
+                  " expected degree is not the power of two: "
+               << degree << "\n";
+            throw std::runtime_error(os.str());
+        }
 
-        std::vector<T> result(degree);
+        INSTRUMENT_SCOPE("SixStepTransform", T, degree);
+        //вектор x длины degree = rows * cols рассматриваем как матрицу
+        //rows x cols: x[cols * n1 + n2], тогда
+        //X[k1 + rows * k2] = sum_n2 w_cols^(n2 * k2) * w^(n2 * k1) *
+        //                    sum_n1 x[cols * n1 + n2] * w_rows^(n1 * k1)
+        size_t log_degree = 0;
+        while ((size_t(1) << log_degree) < degree) {
+            ++log_degree;
+        }
+        size_t rows = size_t(1) << (log_degree / 2);
+        size_t cols = degree / rows;
+        if (transpose == nullptr) {
+            transpose = Transpose<T>;
+        }
 
-        for (size_t i = 0; i < degree / 2; ++i) {
-            result[i] += even_data[i] + curr_inv_root * odd_data[i];
-            result[i + degree / 2] +=  even_data[i] - curr_inv_root * odd_data[i];
-            //делим на два на каждом уровне рекурсии,
-            //тогда в конце произойдет деление на 2^(log_2 n) = n
-            result[i] /= T(2);
-            result[i + degree / 2] /= T(2);
-            curr_inv_root *= inv_root;
+        auto transform_rows = [inverse](T* matrix, size_t count, size_t length) {
+            std::vector<T> row(length);
+            for (size_t i = 0; i < count; ++i) {
+                std::copy(matrix + i * length, matrix + (i + 1) * length, begin(row));
+                //нормировка обратного преобразования делится между двумя проходами:
+                //1 / rows на первом и 1 / cols на втором
+                row = inverse ? FastInverseFourierTransform(row) : FastFourierTransform(row);
+                std::copy(begin(row), end(row), matrix + i * length);
+            }
+        };
+
+        //1. транспонируем, теперь столбцы лежат в памяти подряд
+        transpose(data, buffer, rows, cols);
+        //2. преобразования длины rows над бывшими столбцами
+        transform_rows(buffer, cols, rows);
+        //3. домножаем на поворачивающие множители w^(n2 * k1)
+        //n2 * k1 < degree, w^e = w^(cols * (e / cols)) * w^(e % cols), обе таблицы считаются
+        //напрямую, так что у каждого множителя ошибка в пару eps, а не rows * eps
+        static const typename T::value_type dPI = 2 * std::acos(typename T::value_type(-1));
+        std::vector<T> coarse(rows), fine(cols);
+        for (size_t i = 0; i < rows; ++i) {
+            typename T::value_type angle = dPI * i / rows;
+            coarse[i] = T(std::cos(angle), inverse ? -std::sin(angle) : std::sin(angle));
+        }
+        for (size_t i = 0; i < cols; ++i) {
+            typename T::value_type angle = dPI * i / degree;
+            fine[i] = T(std::cos(angle), inverse ? -std::sin(angle) : std::sin(angle));
+        }
+        for (size_t n2 = 0; n2 < cols; ++n2) {
+            for (size_t k1 = 0; k1 < rows; ++k1) {
+                size_t power = n2 * k1;
+                buffer[n2 * rows + k1] *= coarse[power / cols] * fine[power % cols];
+            }
+        }
+        //4. транспонируем обратно
+        transpose(buffer, data, cols, rows);
+        //5. преобразования длины cols над строками
+        transform_rows(data, rows, cols);
+        //6. транспонируем, чтобы получить X[k1 + rows * k2] в естественном порядке
+        transpose(data, buffer, rows, cols);
+        std::copy(buffer, buffer + degree, data);
+    }
+
+    template <typename T>
+    std::vector<T> SixStepFourierTransform(const std::vector<T>& data) {
+        std::vector<T> result = data;
+        std::vector<T> buffer(data.size());
+        SixStepTransform(result.data(), buffer.data(), result.size(), false);
+        return result;
+    }
+
+    template <typename T>
+    std::vector<T> SixStepInverseFourierTransform(const std::vector<T>& data) {
+        std::vector<T> result = data;
+        std::vector<T> buffer(data.size());
+        SixStepTransform(result.data(), buffer.data(), result.size(), true);
+        return result;
+    }
+
+    template <typename T>
+    void TransformND(T* data, T* buffer, const std::vector<size_t>& shape, bool inverse) {
+        size_t size = 1;
+        for (size_t length : shape) {
+            if (length == 0 || ((length & (length - 1)) != 0)) {
+                std::ostringstream os;
+                os << "Exception thrown in TransformND,"
+                      " expected dimension is not the power of two: "
+                   << length << "\n";
+                throw std::runtime_error(os.str());
+            }
+            size *= length;
+        }
+        INSTRUMENT_SCOPE("TransformND", T, size);
+
+        //массив с размерами (n_1, ..., n_d) - это матрица (size / n_d) x n_d,
+        //после преобразования строк и транспонирования получаем массив
+        //с размерами (n_d, n_1, ..., n_(d-1)), то есть оси сдвинулись по циклу;
+        //через d таких шагов все оси преобразованы и стоят на своих местах
+        T* current = data;
+        T* other = buffer;
+        std::vector<T> row;
+        for (size_t axis = shape.size(); axis > 0; --axis) {
+            size_t length = shape[axis - 1];
+            size_t count = size / length;
+            if (length > 1) {
+                row.resize(length);
+                for (size_t i = 0; i < count; ++i) {
+                    T* begin = current + i * length;
+                    if (FixedTransform(begin, row.data(), length, inverse)) {
+                        std::copy(row.begin(), row.end(), begin);
+                        continue;
+                    }
+                    std::copy(begin, begin + length, row.begin());
+                    row = inverse ? FastInverseFourierTransform(row) : FastFourierTransform(row);
+                    std::copy(row.begin(), row.end(), begin);
+                }
+            }
+            Transpose(current, other, count, length);
+            std::swap(current, other);
+        }
+
+        if (current != data) {
+            std::copy(current, current + size, data);
         }
+    }
+
+    template <typename T>
+    std::vector<T> FastFourierTransform2D(const std::vector<T>& data, size_t rows, size_t cols) {
+        return FastFourierTransformND(data, {rows, cols});
+    }
+
+    template <typename T>
+    std::vector<T> FastInverseFourierTransform2D(const std::vector<T>& data,
+                                                 size_t rows, size_t cols) {
+        return FastInverseFourierTransformND(data, {rows, cols});
+    }
 
+    template <typename T>
+    std::vector<T> FastFourierTransformND(const std::vector<T>& data,
+                                          const std::vector<size_t>& shape) {
+        size_t size = std::accumulate(shape.begin(), shape.end(), size_t(1),
+                                      std::multiplies<size_t>());
+        if (size != data.size()) {
+            std::ostringstream os;
+            os << "Exception thrown in FastFourierTransformND, shape describes "
+               << size << " elements, but data has " << data.size() << "\n";
+            throw std::runtime_error(os.str());
+        }
+        std::vector<T> result = data;
+        std::vector<T> buffer(data.size());
+        TransformND(result.data(), buffer.data(), shape, false);
         return result;
     }
 
+    template <typename T>
+    std::vector<T> FastInverseFourierTransformND(const std::vector<T>& data,
+                                                 const std::vector<size_t>& shape) {
+        size_t size = std::accumulate(shape.begin(), shape.end(), size_t(1),
+                                      std::multiplies<size_t>());
+        if (size != data.size()) {
+            std::ostringstream os;
+            os << "Exception thrown in FastInverseFourierTransformND, shape describes "
+               << size << " elements, but data has " << data.size() << "\n";
+            throw std::runtime_error(os.str());
+        }
+        std::vector<T> result = data;
+        std::vector<T> buffer(data.size());
+        TransformND(result.data(), buffer.data(), shape, true);
+        return result;
+    }
+
+    template <typename T>
+    Plan<T>::Plan(size_t degree)
+        : degree_(degree), roots_(degree), bit_reverse_(degree) {
+        //проверка на степень двойки
+        if (degree == 0 || ((degree & (degree - 1)) != 0)) {
+            std::ostringstream os;
+            os << "Exception thrown in Plan,"
+                  " expected degree is not the power of two: "
+               << degree << "\n";
+            throw std::runtime_error(os.str());
+        }
+
+        //каждый корень считаем отдельно, а не степенями одного корня,
+        //чтобы ошибка не накапливалась
+        static const typename T::value_type PI = std::acos(typename T::value_type(-1));
+        for (size_t half = 1; half < degree; half *= 2) {
+            for (size_t j = 0; j < half; ++j) {
+                typename T::value_type angle = PI * j / half;
+                roots_[half + j] = T(std::cos(angle), std::sin(angle));
+            }
+        }
+
+        for (size_t i = 1; i < degree; ++i) {
+            bit_reverse_[i] = (bit_reverse_[i / 2] / 2) | ((i % 2) * (degree / 2));
+        }
+    }
+
+    template <typename T>
+    void Plan<T>::Forward(T* data) const {
+        Transform(data, false);
+    }
+
+    template <typename T>
+    void Plan<T>::Inverse(T* data) const {
+        Transform(data, true);
+    }
+
+    template <typename T>
+    void Plan<T>::Transform(T* data, bool inverse) const {
+        INSTRUMENT_SCOPE(inverse ? "Plan::Inverse" : "Plan::Forward", T, degree_);
+        for (size_t i = 0; i < degree_; ++i) {
+            if (i < bit_reverse_[i]) {
+                std::swap(data[i], data[bit_reverse_[i]]);
+            }
+        }
+
+        //те же бабочки, что и в рекурсивном FastFourierTransform, снизу вверх
+        for (size_t half = 1; half < degree_; half *= 2) {
+            for (size_t begin = 0; begin < degree_; begin += 2 * half) {
+                for (size_t j = 0; j < half; ++j) {
+                    T root = inverse ? std::conj(roots_[half + j]) : roots_[half + j];
+                    T even = data[begin + j];
+                    T odd = data[begin + j + half] * root;
+                    data[begin + j] = even + odd;
+                    data[begin + j + half] = even - odd;
+                }
+            }
+        }
+
+        if (inverse) {
+            typename T::value_type scale = typename T::value_type(1) / degree_;
+            for (size_t i = 0; i < degree_; ++i) {
+                data[i] *= scale;
+            }
+        }
+    }
+
 
     template std::complex<float> GetRoot<std::complex<float>>(size_t degree);
     template std::complex<double> GetRoot<std::complex<double>>(size_t degree);
@@ -204,4 +505,75 @@ namespace FFT {
     FastInverseFourierTransform(const std::vector<std::complex<double>>& data);
     template std::vector<std::complex<long double>>
     FastInverseFourierTransform(const std::vector<std::complex<long double>>& data);
-}
\ No newline at end of file
+
+    template std::vector<std::complex<float>>
+    SixStepFourierTransform(const std::vector<std::complex<float>>& data);
+    template std::vector<std::complex<double>>
+    SixStepFourierTransform(const std::vector<std::complex<double>>& data);
+    template std::vector<std::complex<long double>>
+    SixStepFourierTransform(const std::vector<std::complex<long double>>& data);
+
+    template std::vector<std::complex<float>>
+    SixStepInverseFourierTransform(const std::vector<std::complex<float>>& data);
+    template std::vector<std::complex<double>>
+    SixStepInverseFourierTransform(const std::vector<std::complex<double>>& data);
+    template std::vector<std::complex<long double>>
+    SixStepInverseFourierTransform(const std::vector<std::complex<long double>>& data);
+
+    template void SixStepTransform(
+        std::complex<float>* data, std::complex<float>* buffer, size_t degree, bool inverse,
+        void (*transpose)(const std::complex<float>*, std::complex<float>*, size_t, size_t));
+    template void SixStepTransform(
+        std::complex<double>* data, std::complex<double>* buffer, size_t degree, bool inverse,
+        void (*transpose)(const std::complex<double>*, std::complex<double>*, size_t, size_t));
+    template void SixStepTransform(
+        std::complex<long double>* data, std::complex<long double>* buffer, size_t degree,
+        bool inverse, void (*transpose)(const std::complex<long double>*,
+                                        std::complex<long double>*, size_t, size_t));
+
+    template void Transpose(const std::complex<float>* src, std::complex<float>* dst,
+                            size_t rows, size_t cols);
+    template void Transpose(const std::complex<double>* src, std::complex<double>* dst,
+                            size_t rows, size_t cols);
+    template void Transpose(const std::complex<long double>* src, std::complex<long double>* dst,
+                            size_t rows, size_t cols);
+
+    template std::vector<std::complex<float>>
+    FastFourierTransform2D(const std::vector<std::complex<float>>& data, size_t rows, size_t cols);
+    template std::vector<std::complex<double>>
+    FastFourierTransform2D(const std::vector<std::complex<double>>& data, size_t rows, size_t cols);
+    template std::vector<std::complex<long double>>
+    FastFourierTransform2D(const std::vector<std::complex<long double>>& data, size_t rows, size_t cols);
+
+    template std::vector<std::complex<float>>
+    FastInverseFourierTransform2D(const std::vector<std::complex<float>>& data, size_t rows, size_t cols);
+    template std::vector<std::complex<double>>
+    FastInverseFourierTransform2D(const std::vector<std::complex<double>>& data, size_t rows, size_t cols);
+    template std::vector<std::complex<long double>>
+    FastInverseFourierTransform2D(const std::vector<std::complex<long double>>& data, size_t rows, size_t cols);
+
+    template std::vector<std::complex<float>>
+    FastFourierTransformND(const std::vector<std::complex<float>>& data, const std::vector<size_t>& shape);
+    template std::vector<std::complex<double>>
+    FastFourierTransformND(const std::vector<std::complex<double>>& data, const std::vector<size_t>& shape);
+    template std::vector<std::complex<long double>>
+    FastFourierTransformND(const std::vector<std::complex<long double>>& data, const std::vector<size_t>& shape);
+
+    template std::vector<std::complex<float>>
+    FastInverseFourierTransformND(const std::vector<std::complex<float>>& data, const std::vector<size_t>& shape);
+    template std::vector<std::complex<double>>
+    FastInverseFourierTransformND(const std::vector<std::complex<double>>& data, const std::vector<size_t>& shape);
+    template std::vector<std::complex<long double>>
+    FastInverseFourierTransformND(const std::vector<std::complex<long double>>& data, const std::vector<size_t>& shape);
+
+    template void TransformND(std::complex<float>* data, std::complex<float>* buffer,
+                             const std::vector<size_t>& shape, bool inverse);
+    template void TransformND(std::complex<double>* data, std::complex<double>* buffer,
+                             const std::vector<size_t>& shape, bool inverse);
+    template void TransformND(std::complex<long double>* data, std::complex<long double>* buffer,
+                             const std::vector<size_t>& shape, bool inverse);
+
+    template class Plan<std::complex<float>>;
+    template class Plan<std::complex<double>>;
+    template class Plan<std::complex<long double>>;
+}
@@ -8,6 +8,8 @@
 #include <iomanip>
 #include <complex>
 #include <initializer_list>
+#include <numeric>
+#include <functional>
 
 // Реализуте пропущенные методы
 // в качестве Т будет использоваться std::complex<float> // <double> // <long double>
@@ -37,6 +39,87 @@ std::vector<T> FastFourierTransform(const std::vector<T>& data);
 template <typename T>
 std::vector<T> FastInverseFourierTransform(const std::vector<T>& data);
 
+// Размер данных в байтах, начиная с которого FastFourierTransform
+// переходит на шестишаговый алгоритм: рекурсивное разбиение на четные и нечетные
+// ходит по памяти с шагом 2^k и перестает помещаться в кэш
+const size_t kSixStepThresholdBytes = size_t(1) << 22;
+
+template <typename T>
+inline constexpr size_t kSixStepThreshold = kSixStepThresholdBytes / sizeof(T);
+
+// Шестишаговое (Bailey) преобразование Фурье для вектора длины 2^k:
+// вектор рассматривается как матрица, строки которой помещаются в кэш,
+// преобразования строк чередуются с блочными транспонированиями
+template <typename T>
+std::vector<T> SixStepFourierTransform(const std::vector<T>& data);
+
+// Обратное шестишаговое преобразование для вектора длины 2^k
+template <typename T>
+std::vector<T> SixStepInverseFourierTransform(const std::vector<T>& data);
+
+// Шестишаговое преобразование на месте для массива data длины degree = 2^k,
+// buffer - рабочая память той же длины. transpose заменяет блочное Transpose
+// между проходами, например, для данных в отображенных файлах
+template <typename T>
+void SixStepTransform(T* data, T* buffer, size_t degree, bool inverse,
+                      void (*transpose)(const T*, T*, size_t, size_t) = nullptr);
+
+// Блочное транспонирование матрицы rows x cols из src в dst
+template <typename T>
+void Transpose(const T* src, T* dst, size_t rows, size_t cols);
+
+// Двумерное преобразование Фурье матрицы rows x cols, записанной по строкам,
+// rows и cols - степени двойки
+template <typename T>
+std::vector<T> FastFourierTransform2D(const std::vector<T>& data, size_t rows, size_t cols);
+
+// Обратное двумерное преобразование матрицы rows x cols
+template <typename T>
+std::vector<T> FastInverseFourierTransform2D(const std::vector<T>& data, size_t rows, size_t cols);
+
+// Многомерное преобразование Фурье массива с размерами shape (последняя ось
+// лежит в памяти подряд), все размеры - степени двойки
+template <typename T>
+std::vector<T> FastFourierTransformND(const std::vector<T>& data, const std::vector<size_t>& shape);
+
+// Обратное многомерное преобразование массива с размерами shape
+template <typename T>
+std::vector<T> FastInverseFourierTransformND(const std::vector<T>& data,
+                                             const std::vector<size_t>& shape);
+
+// Многомерное преобразование на месте: преобразуются непрерывные строки по
+// последней оси, затем блочное транспонирование циклически сдвигает оси,
+// и так shape.size() раз. buffer - рабочая память той же длины
+template <typename T>
+void TransformND(T* data, T* buffer, const std::vector<size_t>& shape, bool inverse);
+
+// План преобразования фиксированной длины degree = 2^k: корни из 1 и
+// битовая перестановка вычисляются один раз в конструкторе, а преобразования
+// выполняются итеративно на месте и не выделяют память
+template <typename T>
+class Plan {
+ public:
+  explicit Plan(size_t degree);
+
+  size_t GetDegree() const {
+      return degree_;
+  }
+
+  // Прямое преобразование массива data длины degree, то же, что FastFourierTransform
+  void Forward(T* data) const;
+
+  // Обратное преобразование с делением на degree
+  void Inverse(T* data) const;
+
+ private:
+  void Transform(T* data, bool inverse) const;
+
+  size_t degree_;
+  // roots_[half + j] - корень степени 2 * half из 1 в степени j
+  std::vector<T> roots_;
+  std::vector<size_t> bit_reverse_;
+};
+
 //Тесты для namespace FFT
 void TestGetRoot();
 void TestFourierTransform();
@@ -44,4 +127,8 @@ void TestInverseFourierTransform();
 void TestAddPadding();
 void TestFastFourierTransform();
 void TestFastInverseFourierTransform();
+void TestSixStepFourierTransform();
+void TestFixedFourierTransform();
+void TestMultidimensionalFourierTransform();
+void TestPlan();
 } // namespace FFT
\ No newline at end of file
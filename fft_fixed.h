@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstdlib>
+#include <utility>
+
+// Преобразования Фурье фиксированной длины N = 2, 4, ..., 64:
+// поворачивающие множители вычисляются при компиляции,
+// бабочки разворачиваются целиком, без рекурсии во время выполнения и выделений памяти
+namespace FFT {
+// Наибольшая длина, для которой есть специализированное преобразование
+const size_t kFixedMaxDegree = 64;
+
+namespace Detail {
+constexpr long double kPi = 3.141592653589793238462643383279502884L;
+
+// Ряды Тейлора, угол берется из [0, pi), поэтому 40 членов хватает с запасом
+constexpr long double ConstexprSin(long double x) {
+    long double term = x;
+    long double result = x;
+    for (int i = 1; i < 40; ++i) {
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        result += term;
+    }
+    return result;
+}
+
+constexpr long double ConstexprCos(long double x) {
+    long double term = 1;
+    long double result = 1;
+    for (int i = 1; i < 40; ++i) {
+        term *= -x * x / ((2 * i - 1) * (2 * i));
+        result += term;
+    }
+    return result;
+}
+
+// Степени w^k, k < N / 2, корня степени N из 1 (сопряженного для обратного преобразования)
+template <typename T, size_t N, bool Inverse>
+struct Twiddles {
+  template <size_t... K>
+  static constexpr std::array<T, N / 2> Make(std::index_sequence<K...>) {
+      using Value = typename T::value_type;
+      return {T(static_cast<Value>(ConstexprCos(2 * kPi * K / N)),
+                static_cast<Value>((Inverse ? -1 : 1) * ConstexprSin(2 * kPi * K / N)))...};
+  }
+
+  static constexpr std::array<T, N / 2> values = Make(std::make_index_sequence<N / 2>{});
+};
+} // namespace Detail
+
+template <size_t N, typename T>
+struct Fixed {
+  static_assert(N >= 1 && N <= kFixedMaxDegree && (N & (N - 1)) == 0,
+                "FFT::Fixed is defined for powers of two up to kFixedMaxDegree");
+
+  // out[k] = sum_j in[j * stride] * w^(j * k), in и out не должны пересекаться
+  static void Forward(const T* in, T* out, size_t stride = 1) {
+      Transform<false>(in, out, stride);
+  }
+
+  // Обратное преобразование, включая деление на N
+  static void Inverse(const T* in, T* out, size_t stride = 1) {
+      Transform<true>(in, out, stride);
+      if constexpr (N > 1) {
+          const typename T::value_type scale = typename T::value_type(1) / N;
+          for (size_t k = 0; k < N; ++k) {
+              out[k] *= scale;
+          }
+      }
+  }
+
+  static std::array<T, N> Forward(const std::array<T, N>& data) {
+      std::array<T, N> result;
+      Forward(data.data(), result.data());
+      return result;
+  }
+
+  static std::array<T, N> Inverse(const std::array<T, N>& data) {
+      std::array<T, N> result;
+      Inverse(data.data(), result.data());
+      return result;
+  }
+
+  // Разбиение на четные и нечетные, раскрываемое при компиляции
+  template <bool IsInverse>
+  static void Transform(const T* in, T* out, size_t stride) {
+      if constexpr (N == 1) {
+          out[0] = in[0];
+      } else if constexpr (N == 2) {
+          out[0] = in[0] + in[stride];
+          out[1] = in[0] - in[stride];
+      } else {
+          Fixed<N / 2, T>::template Transform<IsInverse>(in, out, 2 * stride);
+          Fixed<N / 2, T>::template Transform<IsInverse>(in + stride, out + N / 2, 2 * stride);
+          Butterflies<IsInverse>(out, std::make_index_sequence<N / 2>{});
+      }
+  }
+
+ private:
+  template <bool IsInverse, size_t... K>
+  static void Butterflies(T* out, std::index_sequence<K...>) {
+      (Butterfly<IsInverse, K>(out), ...);
+  }
+
+  template <bool IsInverse, size_t K>
+  static void Butterfly(T* out) {
+      T odd = out[K + N / 2];
+      if constexpr (K != 0) {
+          odd *= Detail::Twiddles<T, N, IsInverse>::values[K];
+      }
+      out[K + N / 2] = out[K] - odd;
+      out[K] = out[K] + odd;
+  }
+};
+
+// Выбирает Fixed<N, T> по длине degree, известной только во время выполнения,
+// возвращает false, если специализированного преобразования такой длины нет
+template <typename T, size_t N = kFixedMaxDegree>
+bool FixedTransform(const T* in, T* out, size_t degree, bool inverse) {
+    if constexpr (N >= 1) {
+        if (degree == N) {
+            if (inverse) {
+                Fixed<N, T>::Inverse(in, out);
+            } else {
+                Fixed<N, T>::Forward(in, out);
+            }
+            return true;
+        }
+        return FixedTransform<T, N / 2>(in, out, degree, inverse);
+    }
+    return false;
+}
+} // namespace FFT
@@ -1,4 +1,5 @@
 #include "fft.h"
+#include "fft_fixed.h"
 #include "test_runner.h"
 
 namespace FFT {
@@ -159,4 +160,149 @@ void TestFastInverseFourierTransform() {
         ), v5, error
     );
 }
+
+void TestSixStepFourierTransform() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-5;
+
+    vector<complex<double>> v1 = {5, 3, 2, 4};
+    ASSERT_VECTOR(FastFourierTransform<complex<double>>(v1),
+                  SixStepFourierTransform<complex<double>>(v1), error);
+
+    //длины вида 2^(2k) и 2^(2k + 1) разбиваются на матрицы разной формы
+    for (size_t degree : {64, 128, 2048}) {
+        vector<complex<long double>> v2(degree);
+        for (size_t i = 0; i < degree; ++i) {
+            v2[i] = complex<long double>(i % 17, (i * 7) % 5);
+        }
+        ASSERT_VECTOR(FastFourierTransform<complex<long double>>(v2),
+                      SixStepFourierTransform<complex<long double>>(v2), error);
+        ASSERT_VECTOR(
+            SixStepInverseFourierTransform<complex<long double>>(
+                SixStepFourierTransform<complex<long double>>(v2)
+            ), v2, error
+        );
+    }
+
+    vector<complex<float>> v3 = {8, 7, 6, 5, 4, 3, 2, 1, 1, 2, 3, 4, 5, 6, 7, 8,
+                                 8, 7, 6, 5, 4, 3, 2, 1, 1, 2, 3, 4, 5, 6, 7, 8};
+    ASSERT_VECTOR(FastInverseFourierTransform<complex<float>>(v3),
+                  SixStepInverseFourierTransform<complex<float>>(v3), error);
+}
+
+void TestFixedFourierTransform() {
+    using std::complex;
+    using std::vector;
+    using std::array;
+
+    const long double error = 1.0e-5;
+
+    array<complex<float>, 4> a1 = {0, 1, 2, 3};
+    vector<complex<float>> v1(begin(a1), end(a1));
+    array<complex<float>, 4> f1 = Fixed<4, complex<float>>::Forward(a1);
+    ASSERT_VECTOR(vector<complex<float>>(begin(f1), end(f1)),
+                  FourierTransform<complex<float>>(v1), error);
+
+    vector<complex<long double>> v2(64);
+    for (size_t i = 0; i < v2.size(); ++i) {
+        v2[i] = complex<long double>(i % 7, i % 3);
+    }
+    vector<complex<long double>> f2(64), i2(64);
+    Fixed<64, complex<long double>>::Forward(v2.data(), f2.data());
+    ASSERT_VECTOR(f2, FourierTransform<complex<long double>>(v2), error);
+    Fixed<64, complex<long double>>::Inverse(f2.data(), i2.data());
+    ASSERT_VECTOR(i2, v2, error);
+
+    //с шагом stride берется каждый второй элемент
+    vector<complex<double>> v3 = {1, 0, 2, 0, 3, 0, 4, 0}, f3(4);
+    Fixed<4, complex<double>>::Forward(v3.data(), f3.data(), 2);
+    ASSERT_VECTOR(f3, FourierTransform<complex<double>>({1, 2, 3, 4}), error);
+}
+
+void TestMultidimensionalFourierTransform() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-9;
+
+    //двумерное преобразование - одномерные преобразования всех строк, затем всех столбцов
+    const size_t rows = 4, cols = 8;
+    vector<complex<double>> matrix(rows * cols);
+    for (size_t i = 0; i < matrix.size(); ++i) {
+        matrix[i] = complex<double>(i % 5, i % 3);
+    }
+    vector<complex<double>> expected(rows * cols);
+    for (size_t row = 0; row < rows; ++row) {
+        vector<complex<double>> line(begin(matrix) + row * cols, begin(matrix) + (row + 1) * cols);
+        line = FourierTransform(line);
+        std::copy(begin(line), end(line), begin(expected) + row * cols);
+    }
+    for (size_t col = 0; col < cols; ++col) {
+        vector<complex<double>> line(rows);
+        for (size_t row = 0; row < rows; ++row) {
+            line[row] = expected[row * cols + col];
+        }
+        line = FourierTransform(line);
+        for (size_t row = 0; row < rows; ++row) {
+            expected[row * cols + col] = line[row];
+        }
+    }
+    ASSERT_VECTOR(FastFourierTransform2D(matrix, rows, cols), expected, error);
+    ASSERT_VECTOR(FastInverseFourierTransform2D(expected, rows, cols), matrix, error);
+
+    //ось длины 1 ничего не меняет
+    ASSERT_VECTOR(FastFourierTransformND(matrix, {1, rows * cols}),
+                  FastFourierTransform(matrix), error);
+
+    //трехмерный массив со строками длиннее кодлетов
+    vector<size_t> shape = {2, 4, 128};
+    vector<complex<long double>> cube(2 * 4 * 128);
+    for (size_t i = 0; i < cube.size(); ++i) {
+        cube[i] = complex<long double>(i % 7, i % 11);
+    }
+    vector<complex<long double>> spectrum = FastFourierTransformND(cube, shape);
+    long double sum = std::accumulate(begin(cube), end(cube), complex<long double>(0)).real();
+    ASSERT_ERROR(spectrum[0].real(), sum, error);
+    ASSERT_VECTOR(FastInverseFourierTransformND(spectrum, shape), cube, error);
+
+    bool thrown = false;
+    try {
+        FastFourierTransformND(cube, {3, 4, 128});
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+
+void TestPlan() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-9;
+
+    for (size_t degree : {1, 2, 8, 256}) {
+        Plan<complex<double>> plan(degree);
+        ASSERT_EQUAL(plan.GetDegree(), degree);
+
+        vector<complex<double>> data(degree);
+        for (size_t i = 0; i < degree; ++i) {
+            data[i] = complex<double>(i % 13, i % 5);
+        }
+        vector<complex<double>> transformed = data;
+        plan.Forward(transformed.data());
+        ASSERT_VECTOR(transformed, FastFourierTransform(data), error);
+        plan.Inverse(transformed.data());
+        ASSERT_VECTOR(transformed, data, error);
+    }
+
+    bool thrown = false;
+    try {
+        Plan<complex<float>> plan(12);
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
 }
\ No newline at end of file
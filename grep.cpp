@@ -0,0 +1,398 @@
+#include "grep.h"
+#include "out_of_core.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+//по замерам один уровень ффт на байт текста стоит примерно как 32 позиции
+//шаблона, проверенные MatchesAt
+const double kFFTLevelCost = 32;
+
+//частота байта в тексте, если образца текста нет
+const double kDefaultByteFrequency = 1.0 / 16;
+
+//образец из начала первого файла, по которому оцениваются частоты байтов
+const size_t kSampleLength = size_t(1) << 16;
+
+//самый длинный кусок шаблона без джокеров: (начало, длина)
+std::pair<size_t, size_t> FindAnchor(const std::string& pattern, char wildcard) {
+    std::pair<size_t, size_t> result = {0, 0};
+    size_t begin = 0;
+    for (size_t i = 0; i <= pattern.size(); ++i) {
+        if (i == pattern.size() || pattern[i] == wildcard) {
+            if (i - begin > result.second) {
+                result = {begin, i - begin};
+            }
+            begin = i + 1;
+        }
+    }
+    return result;
+}
+
+bool MatchesAt(std::string_view text, size_t position, const std::string& pattern,
+               char wildcard) {
+    for (size_t j = 0; j < pattern.size(); ++j) {
+        if (pattern[j] != wildcard && pattern[j] != text[position + j]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//кусок файла для одной задачи: вхождения, начинающиеся в [begin, end)
+struct Task {
+  size_t file;
+  size_t begin;
+  size_t end;
+};
+
+[[noreturn]] void ThrowUsage(const std::string& message) {
+    std::ostringstream os;
+    os << "Exception thrown in Grep::ParseArguments, " << message
+       << "\nusage: grep [-c] [-b] [-j N] [--wildcard=C] [--chunk=BYTES] pattern path...\n";
+    throw std::runtime_error(os.str());
+}
+
+//число из аргумента argument, нечисло - ошибка использования, как и у других опций
+size_t ParseNumber(const std::string& text, const std::string& argument) {
+    try {
+        size_t length = 0;
+        unsigned long value = std::stoul(text, &length);
+        if (length == text.size()) {
+            return value;
+        }
+    } catch (std::logic_error&) {
+    }
+    ThrowUsage("invalid number in " + argument);
+}
+}
+
+namespace Grep {
+Options ParseArguments(int argc, char* argv[]) {
+    Options options;
+    std::vector<std::string> positional;
+    bool options_ended = false;
+    for (int i = 0; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (options_ended || !positional.empty() || argument.size() < 2 || argument[0] != '-') {
+            positional.push_back(argument);
+        } else if (argument == "--") {
+            options_ended = true;
+        } else if (argument == "-c" || argument == "--count") {
+            options.mode = OutputMode::Count;
+        } else if (argument == "-b" || argument == "--offsets") {
+            options.mode = OutputMode::Offsets;
+        } else if (argument == "-j") {
+            if (++i == argc) {
+                ThrowUsage("-j requires a number of threads");
+            }
+            options.threads = ParseNumber(argv[i], argument + " " + argv[i]);
+        } else if (argument.rfind("--wildcard=", 0) == 0) {
+            if (argument.size() != 12) {
+                ThrowUsage("wildcard must be a single character");
+            }
+            options.wildcard = argument.back();
+        } else if (argument.rfind("--chunk=", 0) == 0) {
+            options.chunk_size = std::max<size_t>(1, ParseNumber(argument.substr(8), argument));
+        } else {
+            ThrowUsage("unknown option " + argument);
+        }
+    }
+
+    if (positional.size() < 2) {
+        ThrowUsage("expected a pattern and at least one path");
+    }
+    if (positional[0].empty()) {
+        ThrowUsage("pattern is empty");
+    }
+    options.pattern = positional[0];
+    options.paths.assign(positional.begin() + 1, positional.end());
+    return options;
+}
+
+Matcher ChooseMatcher(const std::string& pattern, char wildcard, std::string_view sample) {
+    if (pattern.find(wildcard) == std::string::npos) {
+        return Matcher::Literal;
+    }
+    auto [anchor_begin, anchor_length] = FindAnchor(pattern, wildcard);
+    if (anchor_length == 0) {
+        return Matcher::Anchored;
+    }
+
+    std::array<double, 256> frequency;
+    frequency.fill(kDefaultByteFrequency);
+    if (!sample.empty()) {
+        frequency.fill(0);
+        for (char symbol : sample) {
+            frequency[static_cast<unsigned char>(symbol)] += 1.0 / sample.size();
+        }
+    }
+    auto frequency_of = [&frequency](char symbol) {
+        return frequency[static_cast<unsigned char>(symbol)];
+    };
+
+    //байты считаются независимыми: якорь находится в доле hits позиций текста,
+    //а MatchesAt проверяет позицию j, если совпали все байты шаблона до нее
+    double hits = 1;
+    for (size_t j = anchor_begin; j < anchor_begin + anchor_length; ++j) {
+        hits *= frequency_of(pattern[j]);
+    }
+    double check_cost = 0, matched = 1;
+    for (size_t j = 0; j < pattern.size() && matched > 0; ++j) {
+        check_cost += matched;
+        bool in_anchor = j >= anchor_begin && j < anchor_begin + anchor_length;
+        if (!in_anchor && pattern[j] != wildcard) {
+            matched *= frequency_of(pattern[j]);
+        }
+    }
+
+    //ффт стоит log2 длины куска уровней на байт текста при любом тексте
+    size_t block_length = SubstringMatching::kBlockLength;
+    while (block_length < 2 * pattern.size()) {
+        block_length *= 2;
+    }
+    double fft_cost = kFFTLevelCost * std::log2(double(block_length));
+    return hits * check_cost > fft_cost ? Matcher::FFT : Matcher::Anchored;
+}
+
+std::vector<size_t> FindInText(std::string_view text, const std::string& pattern,
+                               char wildcard, Matcher matcher,
+                               const SubstringMatching::PatternSpectrum* spectrum) {
+    std::vector<size_t> result;
+    if (pattern.empty() || pattern.size() > text.size()) {
+        return result;
+    }
+
+    if (matcher == Matcher::FFT) {
+        if (spectrum != nullptr) {
+            return SubstringMatching::FindChunked(text, *spectrum);
+        }
+        return SubstringMatching::FindChunked(text, SubstringMatching::PatternSpectrum(pattern,
+                                                                                      wildcard));
+    }
+
+    auto [anchor_begin, anchor_length] = matcher == Matcher::Literal
+        ? std::pair<size_t, size_t>(0, pattern.size())
+        : FindAnchor(pattern, wildcard);
+    size_t last = text.size() - pattern.size();
+
+    //шаблон из одних джокеров подходит везде
+    if (anchor_length == 0) {
+        result.resize(last + 1);
+        for (size_t i = 0; i <= last; ++i) {
+            result[i] = i;
+        }
+        return result;
+    }
+
+    //ищем якорь, начиная с того места, где он окажется при вхождении с позиции 0,
+    //и заканчивая местом, где он окажется при вхождении с позиции last
+    auto anchor = pattern.begin() + anchor_begin;
+    std::boyer_moore_horspool_searcher searcher(anchor, anchor + anchor_length);
+    auto it = text.begin() + anchor_begin;
+    auto end = text.begin() + last + anchor_begin + anchor_length;
+    while (true) {
+        it = std::search(it, end, searcher);
+        if (it == end) {
+            break;
+        }
+        size_t position = (it - text.begin()) - anchor_begin;
+        if (matcher == Matcher::Literal || MatchesAt(text, position, pattern, wildcard)) {
+            result.push_back(position);
+        }
+        ++it;
+    }
+    return result;
+}
+
+std::vector<std::string> CollectFiles(const std::vector<std::string>& paths,
+                                      std::vector<std::string>* errors) {
+    //как grep, каталог, который не открылся, пропускаем и обходим остальные
+    auto report = [errors](const std::filesystem::path& path, const std::error_code& code) {
+        std::ostringstream os;
+        os << "Exception thrown in Grep::CollectFiles, " << path.string() << ": "
+           << code.message() << "\n";
+        if (errors == nullptr) {
+            throw std::runtime_error(os.str());
+        }
+        errors->push_back(os.str());
+    };
+
+    std::vector<std::string> result;
+    for (const auto& path : paths) {
+        std::error_code code;
+        if (!std::filesystem::is_directory(path, code)) {
+            //несуществующий путь сообщит об ошибке SearchFiles
+            result.push_back(path);
+            continue;
+        }
+
+        //обход вручную через error_code: recursive_directory_iterator бросает
+        //исключение на первом же закрытом подкаталоге и дальше не идет
+        std::vector<std::string> nested;
+        std::vector<std::filesystem::path> directories = {path};
+        while (!directories.empty()) {
+            std::filesystem::path directory = std::move(directories.back());
+            directories.pop_back();
+
+            std::filesystem::directory_iterator it(directory, code);
+            for (; !code && it != std::filesystem::directory_iterator(); it.increment(code)) {
+                std::error_code status_code;
+                //символические ссылки на каталоги не раскрываем, как и grep -r
+                if (it->is_directory(status_code) && !it->is_symlink(status_code)) {
+                    directories.push_back(it->path());
+                } else if (it->is_regular_file(status_code)) {
+                    nested.push_back(it->path().string());
+                }
+            }
+            if (code) {
+                report(directory, code);
+            }
+        }
+        std::sort(nested.begin(), nested.end());
+        result.insert(result.end(), nested.begin(), nested.end());
+    }
+    return result;
+}
+
+std::vector<std::vector<size_t>> SearchFiles(const std::vector<std::string>& files,
+                                             const Options& options, ThreadPool& pool,
+                                             std::vector<std::string>* errors) {
+    size_t pattern_size = options.pattern.size();
+
+    std::vector<std::optional<OutOfCore::MappedFile>> mapped(files.size());
+    std::vector<Task> tasks;
+    if (errors != nullptr) {
+        errors->assign(files.size(), "");
+    }
+    for (size_t file = 0; file < files.size(); ++file) {
+        //как grep, файл, который не открылся, пропускаем и ищем в остальных
+        try {
+            mapped[file].emplace(files[file]);
+        } catch (std::runtime_error& error) {
+            if (errors == nullptr) {
+                throw;
+            }
+            (*errors)[file] = error.what();
+            continue;
+        }
+        size_t size = mapped[file]->Size();
+        for (size_t begin = 0; begin + pattern_size <= size; begin += options.chunk_size) {
+            tasks.push_back({file, begin, std::min(size, begin + options.chunk_size)});
+        }
+    }
+
+    //частоты байтов оцениваются по началу первого непустого файла
+    std::string_view sample;
+    for (const auto& file : mapped) {
+        if (file && file->Size() > 0) {
+            sample = file->View().substr(0, kSampleLength);
+            break;
+        }
+    }
+    Matcher matcher = ChooseMatcher(options.pattern, options.wildcard, sample);
+
+    //спектр шаблона один на все куски, задачи только читают его
+    std::optional<SubstringMatching::PatternSpectrum> spectrum;
+    if (matcher == Matcher::FFT) {
+        spectrum.emplace(options.pattern, options.wildcard);
+    }
+
+    //кусок читается с перекрытием pattern_size - 1, чтобы не потерять вхождения на границе,
+    //но отдает только вхождения, начинающиеся в нем самом
+    std::vector<std::vector<size_t>> task_results(tasks.size());
+    pool.ParallelFor(0, tasks.size(), [&](size_t index) {
+        const Task& task = tasks[index];
+        std::string_view text = mapped[task.file]->View();
+        std::string_view window = text.substr(task.begin, task.end - task.begin + pattern_size - 1);
+        for (size_t position : FindInText(window, options.pattern, options.wildcard, matcher,
+                                          spectrum ? &*spectrum : nullptr)) {
+            if (task.begin + position < task.end) {
+                task_results[index].push_back(task.begin + position);
+            }
+        }
+    });
+
+    std::vector<std::vector<size_t>> result(files.size());
+    for (size_t index = 0; index < tasks.size(); ++index) {
+        auto& positions = result[tasks[index].file];
+        positions.insert(positions.end(), task_results[index].begin(), task_results[index].end());
+    }
+    return result;
+}
+
+int Main(int argc, char* argv[], std::ostream& out) {
+    try {
+        Options options = ParseArguments(argc, argv);
+        std::vector<std::string> directory_errors;
+        std::vector<std::string> files = CollectFiles(options.paths, &directory_errors);
+        for (const auto& error : directory_errors) {
+            std::cerr << error;
+        }
+
+        std::unique_ptr<ThreadPool> own_pool;
+        if (options.threads > 0) {
+            own_pool = std::make_unique<ThreadPool>(options.threads);
+        }
+        ThreadPool& pool = own_pool ? *own_pool : GetDefaultThreadPool();
+        std::vector<std::string> errors;
+        std::vector<std::vector<size_t>> matches = SearchFiles(files, options, pool, &errors);
+
+        //как и grep, имя файла печатаем, только если файлов несколько
+        bool with_name = files.size() > 1;
+        bool found = false, failed = !directory_errors.empty();
+        for (size_t file = 0; file < files.size(); ++file) {
+            if (!errors[file].empty()) {
+                std::cerr << errors[file];
+                failed = true;
+                continue;
+            }
+            const std::string prefix = with_name ? files[file] + ":" : "";
+            found = found || !matches[file].empty();
+
+            if (options.mode == OutputMode::Count) {
+                out << prefix << matches[file].size() << "\n";
+                continue;
+            }
+            if (options.mode == OutputMode::Offsets) {
+                for (size_t offset : matches[file]) {
+                    out << prefix << offset << "\n";
+                }
+                continue;
+            }
+
+            //каждая строка с вхождениями печатается один раз; вхождение, в котором
+            //есть '\n', печатается вместе со всеми строками, которые оно задевает
+            OutOfCore::MappedFile mapped(files[file]);
+            std::string_view text = mapped.View();
+            size_t printed_end = 0;
+            for (size_t offset : matches[file]) {
+                if (offset < printed_end) {
+                    continue;
+                }
+                size_t line_begin = offset > 0 ? text.rfind('\n', offset - 1)
+                                               : std::string_view::npos;
+                line_begin = line_begin == std::string_view::npos ? 0 : line_begin + 1;
+                size_t line_end = text.find('\n', offset + options.pattern.size() - 1);
+                line_end = line_end == std::string_view::npos ? text.size() : line_end;
+                line_end = std::max(line_end, line_begin);
+                out << prefix << text.substr(line_begin, line_end - line_begin) << "\n";
+                printed_end = line_end + 1;
+            }
+        }
+        return failed ? 2 : found ? 0 : 1;
+    } catch (std::exception& error) {
+        std::cerr << error.what();
+        return 2;
+    }
+}
+} // namespace Grep
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "substring_matching.h"
+#include "thread_pool.h"
+
+// Поиск шаблона с джокерами в файлах из командной строки:
+//   main grep [-c] [-b] [-j N] [--wildcard=C] [--chunk=BYTES] pattern path...
+// -c - только количество вхождений в каждом файле, -b - смещения вхождений,
+// по умолчанию - строки, содержащие вхождения. Каталоги обходятся рекурсивно.
+// Файлы отображаются в память, большие режутся на куски с перекрытием
+// в pattern.size() - 1 байт, куски всех файлов ищутся параллельно в пуле потоков
+namespace Grep {
+enum class OutputMode {
+  Lines,
+  Offsets,
+  Count,
+};
+
+// Алгоритм поиска, выбирается по шаблону
+enum class Matcher {
+  // Без джокеров: поиск Бойера-Мура-Хорспула
+  Literal,
+  // Самый длинный кусок без джокеров ищется как Literal, остальное проверяется на месте:
+  // O(n * m) в худшем случае, когда якорь встречается часто, а проверка длинная
+  Anchored,
+  // Поиск по кускам через ффт, O(n log m) при любом шаблоне и тексте
+  FFT,
+};
+
+struct Options {
+  std::string pattern;
+  std::vector<std::string> paths;
+  OutputMode mode = OutputMode::Lines;
+  char wildcard = '?';
+  // Размер куска, который ищется одной задачей
+  size_t chunk_size = size_t(1) << 24;
+  // 0 - пул потоков по умолчанию
+  size_t threads = 0;
+};
+
+// Разбирает аргументы после "grep", выбрасывает std::runtime_error на ошибку
+Options ParseArguments(int argc, char* argv[]);
+
+// Шаблон без джокеров ищется как Literal, иначе выбирается более дешевый из Anchored
+// и FFT: Anchored стоит (доля позиций с якорем) * (ожидаемая длина проверки) на байт
+// текста, FFT - log2 длины куска. Частоты байтов оцениваются по sample, образцу
+// текста, а без него считаются равными 1/16
+Matcher ChooseMatcher(const std::string& pattern, char wildcard,
+                      std::string_view sample = {});
+
+// Все вхождения pattern в text, найденные алгоритмом matcher. Для Matcher::FFT
+// можно передать спектр шаблона, построенный один раз на все куски, иначе
+// он строится заново
+std::vector<size_t> FindInText(std::string_view text, const std::string& pattern,
+                               char wildcard, Matcher matcher,
+                               const SubstringMatching::PatternSpectrum* spectrum = nullptr);
+
+// Обычные файлы из paths, каталоги раскрываются рекурсивно в отсортированном порядке.
+// Каталог, который не удалось прочитать, пропускается, а обход продолжается; если
+// задан errors, туда добавляется сообщение о нем, иначе ошибка выбрасывается
+std::vector<std::string> CollectFiles(const std::vector<std::string>& paths,
+                                      std::vector<std::string>* errors = nullptr);
+
+// Вхождения в каждом из files, files[i] соответствует result[i]. Если задан errors,
+// файл, который не удалось открыть, получает пустой результат, а (*errors)[i] -
+// сообщение об ошибке (у остальных - пустую строку), иначе ошибка выбрасывается
+std::vector<std::vector<size_t>> SearchFiles(const std::vector<std::string>& files,
+                                             const Options& options, ThreadPool& pool,
+                                             std::vector<std::string>* errors = nullptr);
+
+// Точка входа режима grep: 0 - найдены вхождения, 1 - не найдены, 2 - ошибка.
+// Как и grep, о файле, который не удалось прочитать, сообщает в std::cerr
+// и продолжает поиск в остальных, но возвращает 2
+int Main(int argc, char* argv[], std::ostream& out);
+
+//Тесты
+void TestFindInText();
+void TestSearchFiles();
+} // namespace Grep
@@ -0,0 +1,146 @@
+#include "grep.h"
+#include "substring_matching.h"
+#include "test_runner.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace Grep {
+namespace {
+int RunMain(std::vector<std::string> arguments, std::string& output) {
+    std::vector<char*> argv;
+    for (auto& argument : arguments) {
+        argv.push_back(argument.data());
+    }
+    std::ostringstream out;
+    int code = Main(int(argv.size()), argv.data(), out);
+    output = out.str();
+    return code;
+}
+}
+
+void TestFindInText() {
+    ASSERT(ChooseMatcher("abc", '?') == Matcher::Literal);
+    ASSERT(ChooseMatcher("a?c", '?') == Matcher::Anchored);
+    ASSERT(ChooseMatcher("a?c", '*') == Matcher::Literal);
+
+    //в тексте из одних 'a' каждая позиция с якорем проверяется на всю длину шаблона,
+    //а в обычном тексте проверка обрывается на первом же несовпавшем байте
+    const std::string all_a(1000, 'a');
+    std::string sparse(5000, '?');
+    for (size_t i = 0; i < sparse.size(); i += 3) {
+        sparse[i] = 'a';
+    }
+    ASSERT(ChooseMatcher(sparse, '?') == Matcher::Anchored);
+    ASSERT(ChooseMatcher(sparse, '?', all_a) == Matcher::FFT);
+    std::string sparse_star = sparse;
+    std::replace(sparse_star.begin(), sparse_star.end(), '?', '*');
+    ASSERT(ChooseMatcher(sparse_star, '*', all_a) == Matcher::FFT);
+    sparse_star.replace(0, 8, "abcdefgh");
+    ASSERT(ChooseMatcher(sparse_star, '*', all_a) == Matcher::Anchored);
+
+    //короткий якорь и длинный хвост джокеров: если якорь частый, Anchored - O(n * m)
+    const std::string gap = "a" + std::string(3000, '?') + "a";
+    ASSERT(ChooseMatcher(gap, '?', all_a) == Matcher::FFT);
+    ASSERT(ChooseMatcher(gap, '?') == Matcher::Anchored);
+    ASSERT(ChooseMatcher("a" + std::string(10000, '?') + "a", '?') == Matcher::FFT);
+    std::string rare_a(1000, 'x');
+    rare_a[500] = 'a';
+    ASSERT(ChooseMatcher(gap, '?', rare_a) == Matcher::Anchored);
+    ASSERT(ChooseMatcher("abcd" + std::string(3000, '?') + "a", '?') == Matcher::Anchored);
+    ASSERT(ChooseMatcher(std::string(100, '?'), '?') == Matcher::Anchored);
+
+    const std::string text = "abracadabra, abacaba and cadabra";
+    for (const std::string pattern : {"abra", "a?a", "?b?", "cad?bra", "???", "a", "zzz"}) {
+        std::vector<size_t> expected = SubstringMatching::FindMatches(text, pattern);
+        ASSERT_EQUAL(FindInText(text, pattern, '?', Matcher::Anchored), expected);
+        ASSERT_EQUAL(FindInText(text, pattern, '?', Matcher::FFT), expected);
+        SubstringMatching::PatternSpectrum spectrum(pattern, '?');
+        ASSERT_EQUAL(FindInText(text, pattern, '?', Matcher::FFT, &spectrum), expected);
+        if (pattern.find('?') == std::string::npos) {
+            ASSERT_EQUAL(FindInText(text, pattern, '?', Matcher::Literal), expected);
+        }
+    }
+
+    std::vector<size_t> star_matches = FindInText("a?c abc a*c", "a*c", '*', Matcher::Anchored);
+    ASSERT_EQUAL(star_matches, std::vector<size_t>({0, 4, 8}));
+    ASSERT_EQUAL(FindInText("a?c abc a*c", "a*c", '*', Matcher::FFT), star_matches);
+    ASSERT_EQUAL(FindInText("a?c abc", "a?c", '*', Matcher::Literal), std::vector<size_t>({0}));
+    ASSERT(FindInText("ab", "abc", '?', Matcher::Anchored).empty());
+}
+
+void TestSearchFiles() {
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "fft_grep_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "nested");
+    const std::string first = (directory / "first.txt").string();
+    const std::string second = (directory / "nested" / "second.txt").string();
+    std::ofstream(first) << "one abc\nabcabc two\nnothing\nlast a-c";
+    std::ofstream(second) << "xyz\n";
+
+    ASSERT_EQUAL(CollectFiles({directory.string()}), std::vector<std::string>({first, second}));
+
+    //куски по 7 байт: вхождения на границах кусков не теряются и не дублируются
+    Options options;
+    options.pattern = "a?c";
+    options.chunk_size = 7;
+    ThreadPool pool(3);
+    std::vector<std::vector<size_t>> matches = SearchFiles({first, second}, options, pool);
+    ASSERT_EQUAL(matches.size(), 2u);
+    ASSERT_EQUAL(matches[0], SubstringMatching::FindMatches(
+        "one abc\nabcabc two\nnothing\nlast a-c", "a?c"));
+    ASSERT(matches[1].empty());
+
+    std::string output;
+    ASSERT_EQUAL(RunMain({"-c", "--chunk=7", "a?c", first}, output), 0);
+    ASSERT_EQUAL(output, "4\n");
+    ASSERT_EQUAL(RunMain({"-b", "-j", "2", "--chunk=5", "abc", first}, output), 0);
+    ASSERT_EQUAL(output, "4\n8\n11\n");
+    ASSERT_EQUAL(RunMain({"--chunk=3", "a?c", first}, output), 0);
+    ASSERT_EQUAL(output, "one abc\nabcabc two\nlast a-c\n");
+    ASSERT_EQUAL(RunMain({"-c", "--wildcard=*", "a*c", directory.string()}, output), 0);
+    ASSERT_EQUAL(output, first + ":4\n" + second + ":0\n");
+    ASSERT_EQUAL(RunMain({"qqq", directory.string()}, output), 1);
+    ASSERT_EQUAL(output, "");
+    ASSERT_EQUAL(RunMain({"-x", "abc", first}, output), 2);
+    ASSERT_EQUAL(RunMain({"-j", "x", "abc", first}, output), 2);
+    ASSERT_EQUAL(RunMain({"--chunk=1k", "abc", first}, output), 2);
+
+    //вхождение, начинающееся с '\n', печатается вместе с обеими строками
+    const std::string lines = (directory / "lines.txt").string();
+    std::ofstream(lines) << "start\nfoo bar\nhello again\n";
+    ASSERT_EQUAL(RunMain({"\nfoo", lines}, output), 0);
+    ASSERT_EQUAL(output, "start\nfoo bar\n");
+
+    //файл, который не открылся, не мешает искать в остальных
+    const std::string missing = (directory / "missing.txt").string();
+    ASSERT_EQUAL(RunMain({"-c", "a?c", missing, first}, output), 2);
+    ASSERT_EQUAL(output, first + ":4\n");
+    std::vector<std::string> errors;
+    matches = SearchFiles({missing, first}, options, pool, &errors);
+    ASSERT(!errors[0].empty());
+    ASSERT(errors[1].empty());
+    ASSERT(matches[0].empty());
+    ASSERT_EQUAL(matches[1].size(), 4u);
+
+    //закрытый подкаталог пропускается, остальные файлы ищутся; у root права
+    //на чтение не проверяются, тогда каталог просто читается
+    const std::filesystem::path closed = directory / "closed";
+    std::filesystem::create_directories(closed / "inner");
+    std::ofstream((closed / "inner" / "hidden.txt").string()) << "abc\n";
+    std::filesystem::permissions(closed, std::filesystem::perms::none);
+    bool readable = static_cast<bool>(std::ifstream((closed / "inner" / "hidden.txt").string()));
+    errors.clear();
+    std::vector<std::string> files = CollectFiles({directory.string()}, &errors);
+    ASSERT(std::find(files.begin(), files.end(), first) != files.end());
+    ASSERT_EQUAL(errors.size(), readable ? 0u : 1u);
+    ASSERT_EQUAL(RunMain({"-c", "a?c", directory.string()}, output), readable ? 0 : 2);
+    ASSERT(output.find(first + ":4\n") != std::string::npos);
+    std::filesystem::permissions(closed, std::filesystem::perms::owner_all);
+
+    std::filesystem::remove_all(directory);
+}
+} // namespace Grep
@@ -0,0 +1,378 @@
+#include "instrumentation.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+//имена замеров интернируются в номера: одинаковые литералы из разных единиц
+//трансляции могут иметь разные адреса, а номер у одной строки один
+struct NameTable {
+  std::mutex mutex;
+  std::unordered_map<std::string, size_t> ids;
+  std::vector<std::string> names;
+};
+
+NameTable& GetNameTable() {
+    static NameTable table;
+    return table;
+}
+
+size_t Intern(const char* name) {
+    NameTable& table = GetNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto [it, inserted] = table.ids.emplace(name, table.names.size());
+    if (inserted) {
+        table.names.push_back(name);
+    }
+    return it->second;
+}
+
+//номер имени по адресу литерала: глобальная таблица под мьютексом
+//нужна только при первой встрече адреса в потоке
+size_t GetNameId(const char* name) {
+    thread_local std::unordered_map<const char*, size_t> cache;
+    auto it = cache.find(name);
+    if (it == cache.end()) {
+        it = cache.emplace(name, Intern(name)).first;
+    }
+    return it->second;
+}
+
+struct Key {
+  size_t name;
+  const char* precision;
+  size_t size;
+
+  bool operator==(const Key& other) const {
+      return name == other.name && precision == other.precision && size == other.size;
+  }
+};
+
+struct KeyHash {
+  size_t operator()(const Key& key) const {
+      return key.name * 31 + std::hash<const void*>()(key.precision) * 17 + key.size;
+  }
+};
+
+//счетчики пишет только поток-владелец, а снимок читает их из другого потока,
+//поэтому они атомарные, но без блокировок и без атомарных сложений
+struct Statistics {
+  Key key;
+  std::atomic<size_t> count{0};
+  std::atomic<uint64_t> total_ns{0};
+  std::atomic<uint64_t> bytes{0};
+};
+
+struct RawEvent {
+  std::atomic<size_t> name{0};
+  std::atomic<const char*> precision{nullptr};
+  std::atomic<size_t> size{0};
+  std::atomic<uint64_t> start_ns{0};
+  std::atomic<uint64_t> duration_ns{0};
+};
+
+//единственный писатель обходится обычными чтением и записью вместо fetch_add
+template <typename U>
+void Add(std::atomic<U>& counter, U value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+//массив, в конец которого дописывает один поток, а читают любые: элементы лежат
+//кусками по kChunk и не переезжают, число готовых элементов публикуется release
+template <typename T, size_t kMaxChunks>
+class AppendOnlyArray {
+ public:
+  static const size_t kChunk = 1024;
+  static const size_t kCapacity = kChunk * kMaxChunks;
+
+  ~AppendOnlyArray() {
+      for (auto& chunk : chunks_) {
+          delete[] chunk.load(std::memory_order_relaxed);
+      }
+  }
+
+  size_t Size() const {
+      return size_.load(std::memory_order_acquire);
+  }
+
+  T& operator[](size_t index) const {
+      return chunks_[index / kChunk].load(std::memory_order_acquire)[index % kChunk];
+  }
+
+  //место под следующий элемент, только для потока-владельца, nullptr, если места нет
+  T* Reserve() {
+      size_t size = size_.load(std::memory_order_relaxed);
+      if (size == kCapacity) {
+          return nullptr;
+      }
+      if (chunks_[size / kChunk].load(std::memory_order_relaxed) == nullptr) {
+          chunks_[size / kChunk].store(new T[kChunk], std::memory_order_release);
+      }
+      return &(*this)[size];
+  }
+
+  //делает видимым элемент, заполненный после Reserve
+  void Publish() {
+      size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  void Clear() {
+      size_.store(0, std::memory_order_release);
+  }
+
+ private:
+  std::array<std::atomic<T*>, kMaxChunks> chunks_{};
+  std::atomic<size_t> size_{0};
+};
+
+//Reset увеличивает эпоху, а поток, заметив новую эпоху, сам обнуляет свой буфер;
+//буферы с устаревшей эпохой снимок считает пустыми
+std::atomic<uint64_t> current_epoch{1};
+
+//буфер одного потока, пишет в него только сам поток
+struct ThreadBuffer {
+  std::atomic<uint64_t> epoch{0};
+  //ключи не удаляются, при сбросе обнуляются только счетчики
+  AppendOnlyArray<Statistics, 1024> statistics;
+  AppendOnlyArray<RawEvent, Instrumentation::kMaxEventsPerThread / 1024> events;
+  std::atomic<size_t> dropped_events{0};
+  size_t thread = 0;
+  //доступны только потоку-владельцу
+  std::unordered_map<Key, Statistics*, KeyHash> index;
+  //сколько активных замеров с данным номером имени сейчас на стеке
+  std::vector<size_t> depth;
+
+  void Synchronize() {
+      uint64_t epoch_now = current_epoch.load(std::memory_order_acquire);
+      if (epoch.load(std::memory_order_relaxed) == epoch_now) {
+          return;
+      }
+      for (size_t i = 0; i < statistics.Size(); ++i) {
+          statistics[i].count.store(0, std::memory_order_relaxed);
+          statistics[i].total_ns.store(0, std::memory_order_relaxed);
+          statistics[i].bytes.store(0, std::memory_order_relaxed);
+      }
+      events.Clear();
+      dropped_events.store(0, std::memory_order_relaxed);
+      epoch.store(epoch_now, std::memory_order_release);
+  }
+
+  Statistics* Find(const Key& key) {
+      auto it = index.find(key);
+      if (it != index.end()) {
+          return it->second;
+      }
+      Statistics* slot = statistics.Reserve();
+      if (slot != nullptr) {
+          slot->key = key;
+          statistics.Publish();
+      }
+      index.emplace(key, slot);
+      return slot;
+  }
+};
+
+//буферы живут до конца программы, чтобы данные завершившихся потоков не пропадали
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+ThreadBuffer& GetThreadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto result = std::make_shared<ThreadBuffer>();
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        result->thread = registry.buffers.size();
+        registry.buffers.push_back(result);
+        return result;
+    }();
+    return *buffer;
+}
+
+void RecordById(size_t name, const char* precision, size_t size,
+                uint64_t start_ns, uint64_t duration_ns, uint64_t bytes) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    buffer.Synchronize();
+
+    Key key{name, precision, size};
+    if (Statistics* statistics = buffer.Find(key)) {
+        Add(statistics->count, size_t(1));
+        Add(statistics->total_ns, duration_ns);
+        Add(statistics->bytes, bytes);
+    }
+    if (RawEvent* event = buffer.events.Reserve()) {
+        event->name.store(name, std::memory_order_relaxed);
+        event->precision.store(precision, std::memory_order_relaxed);
+        event->size.store(size, std::memory_order_relaxed);
+        event->start_ns.store(start_ns, std::memory_order_relaxed);
+        event->duration_ns.store(duration_ns, std::memory_order_relaxed);
+        buffer.events.Publish();
+    } else {
+        Add(buffer.dropped_events, size_t(1));
+    }
+}
+
+std::string Escape(const std::string& str) {
+    std::string result;
+    for (char symbol : str) {
+        if (symbol == '"' || symbol == '\\') {
+            result += '\\';
+        }
+        result += symbol;
+    }
+    return result;
+}
+}
+
+namespace Instrumentation {
+uint64_t Now() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+}
+
+void Record(const char* name, const char* precision, size_t size,
+            uint64_t start_ns, uint64_t duration_ns, uint64_t bytes) {
+    RecordById(GetNameId(name), precision, size, start_ns, duration_ns, bytes);
+}
+
+void Count(const char* name, const char* precision, size_t size, uint64_t bytes) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    buffer.Synchronize();
+    if (Statistics* statistics = buffer.Find({GetNameId(name), precision, size})) {
+        Add(statistics->count, size_t(1));
+        Add(statistics->bytes, bytes);
+    }
+}
+
+Snapshot TakeSnapshot() {
+    //одинаковые литералы точности из разных единиц трансляции могут иметь
+    //разные адреса, поэтому при сборке ключи сравниваются как строки
+    std::map<std::tuple<size_t, std::string, size_t>, Entry> entries;
+    Snapshot result;
+
+    std::vector<std::string> names;
+    {
+        NameTable& table = GetNameTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        names = table.names;
+    }
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> registry_lock(registry.mutex);
+    uint64_t epoch_now = current_epoch.load(std::memory_order_acquire);
+    for (const auto& buffer : registry.buffers) {
+        if (buffer->epoch.load(std::memory_order_acquire) != epoch_now) {
+            continue;
+        }
+        for (size_t i = 0; i < buffer->statistics.Size(); ++i) {
+            const Statistics& statistics = buffer->statistics[i];
+            size_t count = statistics.count.load(std::memory_order_relaxed);
+            if (count == 0) {
+                continue;
+            }
+            const Key& key = statistics.key;
+            Entry& entry = entries[{key.name, key.precision, key.size}];
+            entry.name = names[key.name];
+            entry.precision = key.precision;
+            entry.size = key.size;
+            entry.count += count;
+            entry.total_ns += statistics.total_ns.load(std::memory_order_relaxed);
+            entry.bytes += statistics.bytes.load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < buffer->events.Size(); ++i) {
+            const RawEvent& event = buffer->events[i];
+            result.events.push_back({names[event.name.load(std::memory_order_relaxed)],
+                                     event.precision.load(std::memory_order_relaxed),
+                                     event.size.load(std::memory_order_relaxed),
+                                     event.start_ns.load(std::memory_order_relaxed),
+                                     event.duration_ns.load(std::memory_order_relaxed),
+                                     buffer->thread});
+        }
+        result.dropped_events += buffer->dropped_events.load(std::memory_order_relaxed);
+    }
+
+    for (auto& [key, entry] : entries) {
+        result.entries.push_back(std::move(entry));
+    }
+    std::sort(result.events.begin(), result.events.end(), [](const Event& a, const Event& b) {
+        return a.start_ns < b.start_ns;
+    });
+    return result;
+}
+
+void Reset() {
+    current_epoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::string ToJson(const Snapshot& snapshot) {
+    std::ostringstream os;
+    os << "{\"entries\": [";
+    for (size_t i = 0; i < snapshot.entries.size(); ++i) {
+        const Entry& entry = snapshot.entries[i];
+        os << (i == 0 ? "\n" : ",\n")
+           << "  {\"name\": \"" << Escape(entry.name) << "\", "
+           << "\"precision\": \"" << Escape(entry.precision) << "\", "
+           << "\"size\": " << entry.size << ", "
+           << "\"count\": " << entry.count << ", "
+           << "\"total_ns\": " << entry.total_ns << ", "
+           << "\"bytes\": " << entry.bytes << "}";
+    }
+    os << "\n], \"events\": " << snapshot.events.size()
+       << ", \"dropped_events\": " << snapshot.dropped_events << "}\n";
+    return os.str();
+}
+
+std::string ToChromeTrace(const Snapshot& snapshot) {
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\": [";
+    for (size_t i = 0; i < snapshot.events.size(); ++i) {
+        const Event& event = snapshot.events[i];
+        os << (i == 0 ? "\n" : ",\n")
+           << "  {\"name\": \"" << Escape(event.name) << "\", "
+           << "\"cat\": \"" << Escape(event.precision) << "\", "
+           << "\"ph\": \"X\", "
+           << "\"ts\": " << event.start_ns / 1000.0 << ", "
+           << "\"dur\": " << event.duration_ns / 1000.0 << ", "
+           << "\"pid\": 1, \"tid\": " << event.thread << ", "
+           << "\"args\": {\"size\": " << event.size << "}}";
+    }
+    os << "\n]}\n";
+    return os.str();
+}
+
+ScopedTimer::ScopedTimer(const char* name, const char* precision, size_t size, uint64_t bytes)
+    : name_(GetNameId(name)), precision_(precision), size_(size), bytes_(bytes) {
+    //вложенный замер с тем же именем активен, только если внешних таких нет
+    std::vector<size_t>& depth = GetThreadBuffer().depth;
+    if (depth.size() <= name_) {
+        depth.resize(name_ + 1);
+    }
+    active_ = depth[name_]++ == 0;
+    start_ns_ = active_ ? Now() : 0;
+}
+
+ScopedTimer::~ScopedTimer() {
+    if (active_) {
+        RecordById(name_, precision_, size_, start_ns_, Now() - start_ns_, bytes_);
+    }
+    --GetThreadBuffer().depth[name_];
+}
+} // namespace Instrumentation
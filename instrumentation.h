@@ -0,0 +1,130 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Счетчики и трассировка горячих путей. Макросы INSTRUMENT_* раскрываются в код,
+// только если при сборке определен FFT_INSTRUMENTATION, иначе они пустые и ничего не стоят.
+// Каждый поток пишет в свой буфер без блокировок, имена замеров заменяются номерами
+// при первой встрече литерала в потоке, буферы собираются вместе только в TakeSnapshot.
+// Записи агрегируются по ключу (имя, точность, размер); кроме того, интервалы
+// сохраняются как события для экспорта в формат Chrome trace (chrome://tracing)
+namespace Instrumentation {
+// Название точности для std::complex<float> // <double> // <long double>
+template <typename T>
+const char* PrecisionName() {
+    return "";
+}
+
+template <>
+inline const char* PrecisionName<std::complex<float>>() {
+    return "float";
+}
+
+template <>
+inline const char* PrecisionName<std::complex<double>>() {
+    return "double";
+}
+
+template <>
+inline const char* PrecisionName<std::complex<long double>>() {
+    return "long double";
+}
+
+struct Entry {
+  std::string name;
+  std::string precision;
+  size_t size = 0;
+  size_t count = 0;
+  uint64_t total_ns = 0;
+  uint64_t bytes = 0;
+};
+
+struct Event {
+  std::string name;
+  std::string precision;
+  size_t size = 0;
+  // Время от начала работы программы
+  uint64_t start_ns = 0;
+  uint64_t duration_ns = 0;
+  size_t thread = 0;
+};
+
+struct Snapshot {
+  std::vector<Entry> entries;
+  std::vector<Event> events;
+  // События, не поместившиеся в буфер потока
+  size_t dropped_events = 0;
+};
+
+// Событий в буфере одного потока не больше этого числа, остальные только агрегируются
+const size_t kMaxEventsPerThread = size_t(1) << 16;
+
+// Наносекунды от начала работы программы
+uint64_t Now();
+
+// Добавляет интервал к счетчикам и к событиям текущего потока.
+// name и precision должны жить до конца программы (строковые литералы)
+void Record(const char* name, const char* precision, size_t size,
+            uint64_t start_ns, uint64_t duration_ns, uint64_t bytes = 0);
+
+// Добавляет одно срабатывание без времени, например выделение памяти
+void Count(const char* name, const char* precision, size_t size, uint64_t bytes = 0);
+
+// Собирает данные всех потоков, в том числе уже завершившихся
+Snapshot TakeSnapshot();
+
+// Обнуляет данные всех потоков: каждый поток очищает свой буфер сам при следующей
+// записи, а до того снимок считает его пустым
+void Reset();
+
+std::string ToJson(const Snapshot& snapshot);
+
+// Формат Trace Event: массив событий "X" с временами в микросекундах
+std::string ToChromeTrace(const Snapshot& snapshot);
+
+// Замеряет время жизни объекта. Если тот же name уже замеряется выше по стеку
+// этого потока (рекурсия), интервал не записывается, его покрывает внешний.
+// Проверка за O(1): поток хранит число активных замеров для каждого имени
+class ScopedTimer {
+ public:
+  ScopedTimer(const char* name, const char* precision, size_t size, uint64_t bytes = 0);
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  ~ScopedTimer();
+
+ private:
+  size_t name_;
+  const char* precision_;
+  size_t size_;
+  uint64_t bytes_;
+  uint64_t start_ns_;
+  bool active_;
+};
+
+//Тесты
+void TestRecordAndSnapshot();
+void TestExport();
+} // namespace Instrumentation
+
+#define INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define INSTRUMENTATION_CONCAT(a, b) INSTRUMENTATION_CONCAT_IMPL(a, b)
+
+#ifdef FFT_INSTRUMENTATION
+// Замер до конца текущего блока, T - тип элементов, size - размер задачи
+#define INSTRUMENT_SCOPE(name, T, size)                                        \
+  Instrumentation::ScopedTimer INSTRUMENTATION_CONCAT(_instrument_, __LINE__)( \
+      name, Instrumentation::PrecisionName<T>(), size)
+
+// Выделение count элементов типа T
+#define INSTRUMENT_ALLOCATION(T, count) \
+  Instrumentation::Count("allocation", Instrumentation::PrecisionName<T>(), 0, (count) * sizeof(T))
+#else
+#define INSTRUMENT_SCOPE(name, T, size)
+#define INSTRUMENT_ALLOCATION(T, count)
+#endif
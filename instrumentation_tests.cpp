@@ -0,0 +1,99 @@
+#include "instrumentation.h"
+#include "polynomial.h"
+#include "test_runner.h"
+
+#include <thread>
+
+namespace Instrumentation {
+namespace {
+const Entry* FindEntry(const Snapshot& snapshot, const std::string& name, size_t size) {
+    for (const auto& entry : snapshot.entries) {
+        if (entry.name == name && entry.size == size) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+}
+
+void TestRecordAndSnapshot() {
+    Reset();
+
+    Record("test::record", "double", 8, 100, 50, 16);
+    Record("test::record", "double", 8, 200, 70);
+    Count("test::count", "", 0, 1024);
+
+    //вложенный замер с тем же именем покрывается внешним
+    {
+        ScopedTimer outer("test::timer", "float", 4);
+        ScopedTimer inner("test::timer", "float", 2);
+        ScopedTimer other("test::other", "float", 2);
+    }
+
+    //данные других потоков, в том числе завершившихся, тоже попадают в снимок
+    std::thread worker([] {
+        Record("test::record", "double", 8, 300, 30);
+    });
+    worker.join();
+
+    Snapshot snapshot = TakeSnapshot();
+
+    const Entry* record = FindEntry(snapshot, "test::record", 8);
+    ASSERT(record != nullptr);
+    ASSERT_EQUAL(record->precision, "double");
+    ASSERT_EQUAL(record->count, 3u);
+    ASSERT_EQUAL(record->total_ns, 150u);
+    ASSERT_EQUAL(record->bytes, 16u);
+
+    const Entry* count = FindEntry(snapshot, "test::count", 0);
+    ASSERT(count != nullptr);
+    ASSERT_EQUAL(count->count, 1u);
+    ASSERT_EQUAL(count->total_ns, 0u);
+    ASSERT_EQUAL(count->bytes, 1024u);
+
+    ASSERT(FindEntry(snapshot, "test::timer", 4) != nullptr);
+    ASSERT(FindEntry(snapshot, "test::timer", 2) == nullptr);
+    ASSERT(FindEntry(snapshot, "test::other", 2) != nullptr);
+
+    //3 записи Record и 2 замера
+    ASSERT_EQUAL(snapshot.events.size(), 5u);
+    for (size_t i = 1; i < snapshot.events.size(); ++i) {
+        ASSERT(snapshot.events[i - 1].start_ns <= snapshot.events[i].start_ns);
+    }
+
+#ifdef FFT_INSTRUMENTATION
+    //при включенной инструментации умножение записывает свои стадии
+    Polynomial<std::complex<double>> p1({1, 2, 3}), p2({4, 5});
+    p1 *= p2;
+    snapshot = TakeSnapshot();
+    ASSERT(FindEntry(snapshot, "Polynomial::operator*=", 8) != nullptr);
+    ASSERT(FindEntry(snapshot, "Polynomial::operator*= forward", 8) != nullptr);
+    ASSERT(FindEntry(snapshot, "Polynomial::operator*= pointwise", 8) != nullptr);
+    ASSERT(FindEntry(snapshot, "Polynomial::operator*= inverse", 8) != nullptr);
+    ASSERT(FindEntry(snapshot, "FastFourierTransform", 8)->count == 2);
+#endif
+
+    Reset();
+    snapshot = TakeSnapshot();
+    ASSERT(FindEntry(snapshot, "test::record", 8) == nullptr);
+    ASSERT(snapshot.events.empty());
+}
+
+void TestExport() {
+    Snapshot snapshot;
+    snapshot.entries.push_back({"FastFourierTransform", "double", 1024, 3, 4500, 49152});
+    snapshot.events.push_back({"FastFourierTransform", "double", 1024, 2000, 1500, 1});
+
+    std::string json = ToJson(snapshot);
+    ASSERT(json.find("\"name\": \"FastFourierTransform\"") != std::string::npos);
+    ASSERT(json.find("\"total_ns\": 4500") != std::string::npos);
+    ASSERT(json.find("\"dropped_events\": 0") != std::string::npos);
+
+    std::string trace = ToChromeTrace(snapshot);
+    ASSERT(trace.find("\"traceEvents\"") != std::string::npos);
+    ASSERT(trace.find("\"ph\": \"X\"") != std::string::npos);
+    ASSERT(trace.find("\"ts\": 2.000") != std::string::npos);
+    ASSERT(trace.find("\"dur\": 1.500") != std::string::npos);
+    ASSERT(trace.find("\"tid\": 1") != std::string::npos);
+}
+} // namespace Instrumentation
@@ -0,0 +1,225 @@
+#include "integer_multiplication.h"
+#include "accuracy.h"
+#include "fft.h"
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace IntegerMultiplication {
+    namespace {
+        using Complex = std::complex<double>;
+
+        //ширина частей выбирается так, чтобы оценка погрешности была меньше 1/4;
+        //если отклонение после округления все же больше, части укорачиваются
+        const double kMaxRoundingError = 0.25;
+
+        thread_local double last_rounding_error = 0;
+
+        size_t BitLength(uint64_t value) {
+            size_t bits = 0;
+            while (value > 0) {
+                ++bits;
+                value >>= 1;
+            }
+            return bits;
+        }
+
+        size_t TransformLength(size_t future_degree) {
+            size_t length = 1;
+            while (length < future_degree) {
+                length *= 2;
+            }
+            return length;
+        }
+
+        //оценка Accuracy::ConvolutionErrorBound для коэффициентов произведений частей.
+        //Части меньше 2^limb_bits по модулю, в упакованном векторе их две, поэтому
+        //его норма не больше sqrt(2 * size) * 2^limb_bits. Спектр произведения с
+        //номером s - сумма не больше limb_count попарных произведений, и при обратном
+        //преобразовании два таких спектра снова упакованы в один вектор
+        double RoundingErrorBound(size_t limb_bits, size_t limb_count,
+                                  size_t first_size, size_t second_size, size_t length) {
+            double limb = std::ldexp(1.0, static_cast<int>(limb_bits));
+            double first_norm = std::sqrt(2.0 * first_size) * limb;
+            double second_norm = std::sqrt(2.0 * second_size) * limb;
+            return 2.0 * limb_count * Accuracy::ConvolutionErrorBound(
+                first_norm, second_norm, length, std::numeric_limits<double>::epsilon());
+        }
+
+        uint64_t Magnitude(int64_t value) {
+            //через беззнаковый тип, чтобы не переполниться на INT64_MIN
+            return value < 0 ? ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+        }
+
+        //части |value| по limb_bits бит со знаком value
+        std::vector<std::vector<double>> Split(const std::vector<int64_t>& values,
+                                               size_t limb_bits, size_t limb_count) {
+            std::vector<std::vector<double>> limbs(limb_count, std::vector<double>(values.size()));
+            const uint64_t mask = (uint64_t(1) << limb_bits) - 1;
+            for (size_t i = 0; i < values.size(); ++i) {
+                uint64_t magnitude = Magnitude(values[i]);
+                double sign = values[i] < 0 ? -1 : 1;
+                for (size_t j = 0; j < limb_count; ++j) {
+                    limbs[j][i] = sign * static_cast<double>(magnitude & mask);
+                    magnitude >>= limb_bits;
+                }
+            }
+            return limbs;
+        }
+
+        //спектры действительных векторов, по два за одно комплексное преобразование:
+        //для P = A + iB верно A^[k] = (P[k] + conj(P[-k])) / 2, B^[k] = (P[k] - conj(P[-k])) / 2i
+        std::vector<std::vector<Complex>> Transform(const std::vector<std::vector<double>>& limbs,
+                                                    size_t length) {
+            std::vector<std::vector<Complex>> result(limbs.size());
+            for (size_t j = 0; j < limbs.size(); j += 2) {
+                std::vector<Complex> packed(length);
+                for (size_t i = 0; i < limbs[j].size(); ++i) {
+                    packed[i] = Complex(limbs[j][i], j + 1 < limbs.size() ? limbs[j + 1][i] : 0);
+                }
+                packed = FFT::FastFourierTransform(packed);
+
+                result[j].resize(length);
+                if (j + 1 < limbs.size()) {
+                    result[j + 1].resize(length);
+                }
+                for (size_t k = 0; k < length; ++k) {
+                    Complex mirrored = std::conj(packed[(length - k) % length]);
+                    result[j][k] = (packed[k] + mirrored) / 2.0;
+                    if (j + 1 < limbs.size()) {
+                        result[j + 1][k] = (packed[k] - mirrored) / Complex(0, 2);
+                    }
+                }
+            }
+            return result;
+        }
+
+        //возвращает false, если погрешность округления слишком велика
+        bool MultiplyWithLimbs(const std::vector<int64_t>& first,
+                               const std::vector<int64_t>& second,
+                               size_t limb_bits, size_t limb_count,
+                               std::vector<__int128>& result) {
+            size_t future_degree = first.size() + second.size() - 1;
+            size_t length = TransformLength(future_degree);
+
+            std::vector<std::vector<Complex>> first_values =
+                Transform(Split(first, limb_bits, limb_count), length);
+            std::vector<std::vector<Complex>> second_values =
+                Transform(Split(second, limb_bits, limb_count), length);
+
+            //спектр свертки частей с суммарным номером s
+            size_t product_count = 2 * limb_count - 1;
+            std::vector<std::vector<Complex>> products(product_count,
+                                                       std::vector<Complex>(length));
+            for (size_t i = 0; i < limb_count; ++i) {
+                for (size_t j = 0; j < limb_count; ++j) {
+                    for (size_t k = 0; k < length; ++k) {
+                        products[i + j][k] += first_values[i][k] * second_values[j][k];
+                    }
+                }
+            }
+
+            //сумма копится в unsigned __int128 по модулю 2^128 без переполнения, а
+            //приближение в long double нужно, чтобы заметить выход за 128 бит со знаком
+            std::vector<unsigned __int128> exact(future_degree, 0);
+            std::vector<long double> approximate(future_degree, 0);
+            double max_error = 0;
+
+            //результаты действительные, поэтому обратные преобразования тоже по два
+            for (size_t s = 0; s < product_count; s += 2) {
+                std::vector<Complex> packed(length);
+                for (size_t k = 0; k < length; ++k) {
+                    packed[k] = products[s][k] +
+                        (s + 1 < product_count ? Complex(0, 1) * products[s + 1][k] : Complex(0));
+                }
+                packed = FFT::FastInverseFourierTransform(packed);
+
+                for (size_t i = 0; i < future_degree; ++i) {
+                    double low = std::round(packed[i].real());
+                    double high = std::round(packed[i].imag());
+                    max_error = std::max({max_error, std::abs(packed[i].real() - low),
+                                          std::abs(packed[i].imag() - high)});
+
+                    exact[i] += static_cast<unsigned __int128>(static_cast<__int128>(low)) <<
+                        (s * limb_bits);
+                    approximate[i] += std::ldexp(static_cast<long double>(low),
+                                                 static_cast<int>(s * limb_bits));
+                    if (s + 1 < product_count) {
+                        exact[i] += static_cast<unsigned __int128>(static_cast<__int128>(high)) <<
+                            ((s + 1) * limb_bits);
+                        approximate[i] += std::ldexp(static_cast<long double>(high),
+                                                     static_cast<int>((s + 1) * limb_bits));
+                    }
+                }
+            }
+
+            last_rounding_error = max_error;
+            if (max_error > kMaxRoundingError) {
+                return false;
+            }
+
+            //значение в диапазоне __int128 совпадает с приближением с точностью до
+            //малой доли 2^126, а при переполнении отличается от него на кратное 2^128
+            result.resize(future_degree);
+            for (size_t i = 0; i < future_degree; ++i) {
+                result[i] = static_cast<__int128>(exact[i]);
+                if (std::abs(static_cast<long double>(result[i]) - approximate[i]) >
+                    std::ldexp(1.0L, 126)) {
+                    std::ostringstream os;
+                    os << "Exception thrown in MultiplyExact, coefficient " << i
+                       << " of the product does not fit in 128 bits\n";
+                    throw std::runtime_error(os.str());
+                }
+            }
+            return true;
+        }
+    }
+
+    std::vector<__int128> MultiplyExact(const std::vector<int64_t>& first,
+                                        const std::vector<int64_t>& second) {
+        if (first.empty() || second.empty()) {
+            return {};
+        }
+
+        uint64_t max_magnitude = 0;
+        for (int64_t value : first) {
+            max_magnitude = std::max(max_magnitude, Magnitude(value));
+        }
+        for (int64_t value : second) {
+            max_magnitude = std::max(max_magnitude, Magnitude(value));
+        }
+        size_t value_bits = std::max<size_t>(BitLength(max_magnitude), 1);
+
+        size_t length = TransformLength(first.size() + second.size() - 1);
+        size_t limb_bits = std::min<size_t>(value_bits, 32);
+
+        while (true) {
+            size_t limb_count = (value_bits + limb_bits - 1) / limb_bits;
+
+            //оценка меньше 1/4, значит, и сами значения меньше 2^53 и точны в double
+            if (RoundingErrorBound(limb_bits, limb_count, first.size(), second.size(),
+                                   length) < kMaxRoundingError) {
+                std::vector<__int128> result;
+                if (MultiplyWithLimbs(first, second, limb_bits, limb_count, result)) {
+                    return result;
+                }
+            }
+
+            if (limb_bits == 1) {
+                std::ostringstream os;
+                os << "Exception thrown in MultiplyExact, rounding error exceeds "
+                   << kMaxRoundingError << " for " << first.size() << " x "
+                   << second.size() << " coefficients\n";
+                throw std::runtime_error(os.str());
+            }
+            --limb_bits;
+        }
+    }
+
+    double GetLastRoundingError() {
+        return last_rounding_error;
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Точное умножение многочленов с целыми коэффициентами.
+// std::complex<long double> в Polynomial хранит 64 бита мантиссы, и произведения
+// 32-64-битных коэффициентов молча округляются. Здесь коэффициенты режутся на
+// короткие части (limbs), произведения частей считаются FFT в double и собираются
+// обратно. Ширина частей выбирается по оценке Accuracy::ConvolutionErrorBound,
+// которая учитывает число слагаемых и ошибку корней из 1: пока оценка меньше 1/4,
+// каждое значение округляется к верному целому. Наблюдаемое отклонение от целых
+// дополнительно проверяется, но само по себе ошибку 3/4 и больше не заметило бы
+namespace IntegerMultiplication {
+// Точное произведение, если его коэффициенты помещаются в __int128.
+// Бросает std::runtime_error, если какой-то коэффициент в __int128 не помещается,
+// или если даже для однобитных частей оценка или наблюдаемое отклонение от целых
+// не меньше 1/4
+std::vector<__int128> MultiplyExact(const std::vector<int64_t>& first,
+                                    const std::vector<int64_t>& second);
+
+// Наибольшее отклонение от ближайшего целого среди коэффициентов
+// последнего произведения частей в этом потоке
+double GetLastRoundingError();
+
+//Тесты
+void TestMultiplyExact();
+void TestMultiplyLarge();
+} // namespace IntegerMultiplication
@@ -0,0 +1,87 @@
+#include "integer_multiplication.h"
+#include "polynomial.h"
+#include "test_runner.h"
+
+#include <random>
+
+namespace IntegerMultiplication {
+namespace {
+std::vector<__int128> MultiplyNaive(const std::vector<int64_t>& first,
+                                    const std::vector<int64_t>& second) {
+    std::vector<__int128> result(first.size() + second.size() - 1);
+    for (size_t i = 0; i < first.size(); ++i) {
+        for (size_t j = 0; j < second.size(); ++j) {
+            result[i + j] += static_cast<__int128>(first[i]) * second[j];
+        }
+    }
+    return result;
+}
+}
+
+void TestMultiplyExact() {
+    ASSERT(MultiplyExact({1, 2, 3}, {3, 2, 1}) == std::vector<__int128>({3, 8, 14, 8, 3}));
+    ASSERT(MultiplyExact({-4, 3, 0, 6}, {1, 2, 3}) == MultiplyNaive({-4, 3, 0, 6}, {1, 2, 3}));
+
+    //произведения 64-битных коэффициентов не помещаются в мантиссу long double
+    std::vector<int64_t> v1 = {INT64_MAX, INT64_MIN, -1, 1234567890123456789LL};
+    std::vector<int64_t> v2 = {INT64_MAX, 987654321987654321LL, INT64_MIN + 1};
+    ASSERT(MultiplyExact(v1, v2) == MultiplyNaive(v1, v2));
+    ASSERT(GetLastRoundingError() <= 0.25);
+
+    //2 * 2^126 = 2^127 уже не помещается в __int128, а -2^127 еще помещается
+    ASSERT(MultiplyExact({INT64_MIN, 0}, {INT64_MIN, INT64_MIN}) ==
+           std::vector<__int128>({static_cast<__int128>(1) << 126,
+                                  static_cast<__int128>(1) << 126, 0}));
+    ASSERT(MultiplyExact({INT64_MIN, INT64_MIN}, {INT64_MAX, INT64_MIN}) ==
+           MultiplyNaive({INT64_MIN, INT64_MIN}, {INT64_MAX, INT64_MIN}));
+    {
+        bool thrown = false;
+        try {
+            MultiplyExact({INT64_MIN, INT64_MIN}, {INT64_MIN, INT64_MIN});
+        } catch (std::runtime_error&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+
+    //точный режим Polynomial: коэффициенты произведения меньше 2^60 и помещаются
+    //в мантиссу long double, а FFT в long double дает их лишь с точностью ~0.1
+    using Complex = std::complex<long double>;
+    std::vector<int64_t> w1(64, (int64_t(1) << 27) - 1), w2(64, -(int64_t(1) << 27) + 7);
+    std::vector<Complex> c1(begin(w1), end(w1)), c2(begin(w2), end(w2));
+    std::vector<__int128> expected = MultiplyNaive(w1, w2);
+    std::vector<Complex> product =
+        Polynomial<Complex>(c1).MultiplyExact(Polynomial<Complex>(c2)).GetCoefficients();
+    ASSERT_EQUAL(product.size(), expected.size());
+    for (size_t i = 0; i < product.size(); ++i) {
+        ASSERT(product[i] == Complex(static_cast<long double>(expected[i])));
+    }
+
+    for (const auto& wrong : {Polynomial<Complex>({1.5}), Polynomial<Complex>({Complex(1, 1)}),
+                              Polynomial<Complex>({std::ldexp(1.0L, 63)}),
+                              Polynomial<Complex>({-std::ldexp(1.0L, 63), -std::ldexp(1.0L, 63)})}) {
+        bool thrown = false;
+        try {
+            //последний множитель в квадрате дает 2^127 в среднем коэффициенте
+            wrong.MultiplyExact(wrong.GetDegree() == 2 ? wrong : Polynomial<Complex>({1}));
+        } catch (std::runtime_error&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+}
+
+void TestMultiplyLarge() {
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int64_t> distribution(INT32_MIN, INT32_MAX);
+
+    std::vector<int64_t> v1(3000), v2(2000);
+    for (auto& value : v1) {
+        value = distribution(generator);
+    }
+    for (auto& value : v2) {
+        value = distribution(generator);
+    }
+    ASSERT(MultiplyExact(v1, v2) == MultiplyNaive(v1, v2));
+}
+} // namespace IntegerMultiplication
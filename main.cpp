@@ -2,6 +2,20 @@
 #include "fft.h"
 #include "polynomial.h"
 #include "substring_matching.h"
+#include "out_of_core.h"
+#include "thread_pool.h"
+#include "async_operations.h"
+#include "spectral_polynomial.h"
+#include "integer_multiplication.h"
+#include "big_integer.h"
+#include "convolution.h"
+#include "stft.h"
+#include "benchmark.h"
+#include "instrumentation.h"
+#include "accuracy.h"
+#include "grep.h"
+#include "spectral_index.h"
+#include "alphabet.h"
 #include "profile.h"
 
 //Запуск всех тестов
@@ -13,20 +27,82 @@ void TestAll() {
     RUN_TEST(tr, FFT::TestAddPadding);
     RUN_TEST(tr, FFT::TestFastFourierTransform);
     RUN_TEST(tr, FFT::TestFastInverseFourierTransform);
+    RUN_TEST(tr, FFT::TestSixStepFourierTransform);
+    RUN_TEST(tr, FFT::TestFixedFourierTransform);
+    RUN_TEST(tr, FFT::TestMultidimensionalFourierTransform);
+    RUN_TEST(tr, FFT::TestPlan);
     RUN_TEST(tr, PolynomialTests::CompareOperator);
     RUN_TEST(tr, PolynomialTests::AddAndSubstractOperators);
     RUN_TEST(tr, PolynomialTests::OutputStream);
     RUN_TEST(tr, PolynomialTests::Multiply);
     RUN_TEST(tr, PolynomialTests::Power);
+    RUN_TEST(tr, PolynomialTests::LazyExpressions);
+    RUN_TEST(tr, PolynomialTests::Division);
+    RUN_TEST(tr, PolynomialTests::EvaluateAndInterpolate);
+    RUN_TEST(tr, PolynomialTests::Product);
+    RUN_TEST(tr, PolynomialTests::PowerSeries);
+    RUN_TEST(tr, SpectralPolynomialTests::Conversion);
+    RUN_TEST(tr, SpectralPolynomialTests::Arithmetic);
+    RUN_TEST(tr, SpectralPolynomialTests::Growth);
+    RUN_TEST(tr, IntegerMultiplication::TestMultiplyExact);
+    RUN_TEST(tr, IntegerMultiplication::TestMultiplyLarge);
+    RUN_TEST(tr, BigIntTests::Conversion);
+    RUN_TEST(tr, BigIntTests::AddAndSubtract);
+    RUN_TEST(tr, BigIntTests::Multiply);
+    RUN_TEST(tr, ConvolutionTests::Linear);
+    RUN_TEST(tr, ConvolutionTests::CircularAndCorrelation);
+    RUN_TEST(tr, ConvolutionTests::Streaming);
+    RUN_TEST(tr, ShortTimeFourierTransformTests::AnalyzeAndSynthesize);
+    RUN_TEST(tr, ShortTimeFourierTransformTests::Streaming);
+    RUN_TEST(tr, Benchmark::TestMeasure);
+    RUN_TEST(tr, Benchmark::TestJson);
+    RUN_TEST(tr, Instrumentation::TestRecordAndSnapshot);
+    RUN_TEST(tr, Instrumentation::TestExport);
+    RUN_TEST(tr, Accuracy::TestRecord);
+    RUN_TEST(tr, Accuracy::TestErrorBound);
+    RUN_TEST(tr, Accuracy::TestPolynomialAndMatching);
     RUN_TEST(tr, SubstringMatching::TestSubstrings);
     RUN_TEST(tr, SubstringMatching::TestSubstringsHeyJude);
     RUN_TEST(tr, SubstringMatching::TestMatches);
     RUN_TEST(tr, SubstringMatching::TestMatchesHeyJude);
+    RUN_TEST(tr, SubstringMatching::TestMatches2D);
+    RUN_TEST(tr, SubstringMatching::TestChunked);
+    RUN_TEST(tr, SubstringMatching::TestResultModes);
+    RUN_TEST(tr, SubstringMatching::TestStreamMatcher);
+    RUN_TEST(tr, SubstringMatching::TestBatch);
+    RUN_TEST(tr, SubstringMatching::TestSpectralIndex);
+    RUN_TEST(tr, SubstringMatching::TestAlphabet);
+    RUN_TEST(tr, SubstringMatching::TestFindMatchesAlphabet);
+    RUN_TEST(tr, Grep::TestFindInText);
+    RUN_TEST(tr, Grep::TestSearchFiles);
+    RUN_TEST(tr, OutOfCore::TestMappedArray);
+    RUN_TEST(tr, OutOfCore::TestMappedFile);
+    RUN_TEST(tr, OutOfCore::TestTransposePanels);
+    RUN_TEST(tr, OutOfCore::TestFastFourierTransform);
+    RUN_TEST(tr, OutOfCore::TestMultiplyPolynomials);
+    RUN_TEST(tr, ThreadPoolTests::SubmitAndSteal);
+    RUN_TEST(tr, ThreadPoolTests::ParallelFor);
+    RUN_TEST(tr, Async::TestTransformAsync);
+    RUN_TEST(tr, Async::TestMultiplyAsync);
+    RUN_TEST(tr, Async::TestMultiplyCallback);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     //TestAll();
 
+#ifdef FFT_BENCHMARK
+    //main --benchmark [--filter=...] [--json=...] [--baseline=...],
+    //только в сборке замеров, где operator new считает выделения
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        return Benchmark::Main(argc - 2, argv + 2);
+    }
+#endif
+
+    //main grep [-c] [-b] [-j N] [--wildcard=C] [--chunk=BYTES] pattern path...
+    if (argc > 1 && std::string(argv[1]) == "grep") {
+        return Grep::Main(argc - 2, argv + 2, std::cout);
+    }
+
     Polynomial<std::complex<long double>> p1({1, 2, 3}), p2({-4, 3, 0, 6});
 
     std::cout << (p1 * p2);
@@ -0,0 +1,308 @@
+#include "out_of_core.h"
+#include "fft.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OutOfCore {
+    namespace {
+        [[noreturn]] void ThrowSystemError(const std::string& function, const std::string& path) {
+            std::ostringstream os;
+            os << "Exception thrown in " << function << ", "
+               << path << ": " << std::strerror(errno) << "\n";
+            throw std::runtime_error(os.str());
+        }
+
+        //кусок панели в памяти занимает не больше стольких байт
+        const size_t kPanelBytes = size_t(1) << 24;
+    }
+
+    template <typename T>
+    MappedArray<T>::MappedArray(std::string path, int descriptor, size_t size)
+        : path_(std::move(path)), descriptor_(descriptor), size_(size) {
+        if (size_ == 0) {
+            Close();
+            std::ostringstream os;
+            os << "Exception thrown in MappedArray, file is empty: " << path_ << "\n";
+            throw std::runtime_error(os.str());
+        }
+
+        void* address = mmap(nullptr, size_ * sizeof(T), PROT_READ | PROT_WRITE,
+                             MAP_SHARED, descriptor_, 0);
+        if (address == MAP_FAILED) {
+            Close();
+            ThrowSystemError("MappedArray", path_);
+        }
+        data_ = static_cast<T*>(address);
+    }
+
+    template <typename T>
+    MappedArray<T> MappedArray<T>::Create(const std::string& path, size_t size) {
+        int descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (descriptor < 0) {
+            ThrowSystemError("MappedArray::Create", path);
+        }
+        //файл, расширенный ftruncate, заполнен нулями
+        if (ftruncate(descriptor, size * sizeof(T)) != 0) {
+            close(descriptor);
+            ThrowSystemError("MappedArray::Create", path);
+        }
+        return MappedArray(path, descriptor, size);
+    }
+
+    template <typename T>
+    MappedArray<T> MappedArray<T>::Open(const std::string& path) {
+        int descriptor = open(path.c_str(), O_RDWR);
+        if (descriptor < 0) {
+            ThrowSystemError("MappedArray::Open", path);
+        }
+        struct stat file_stat;
+        if (fstat(descriptor, &file_stat) != 0) {
+            close(descriptor);
+            ThrowSystemError("MappedArray::Open", path);
+        }
+        //обрезанный файл или файл с элементами другой точности
+        if (file_stat.st_size % sizeof(T) != 0) {
+            close(descriptor);
+            std::ostringstream os;
+            os << "Exception thrown in MappedArray::Open, " << path << ": size "
+               << file_stat.st_size << " is not a multiple of element size " << sizeof(T) << "\n";
+            throw std::runtime_error(os.str());
+        }
+        return MappedArray(path, descriptor, file_stat.st_size / sizeof(T));
+    }
+
+    template <typename T>
+    MappedArray<T> MappedArray<T>::CreateTemporary(const std::string& directory, size_t size) {
+        std::string path = directory + "/fft_scratch_XXXXXX";
+        int descriptor = mkstemp(path.data());
+        if (descriptor < 0) {
+            ThrowSystemError("MappedArray::CreateTemporary", path);
+        }
+        //имя сразу удаляем, место на диске освободится после munmap и close
+        unlink(path.c_str());
+        if (ftruncate(descriptor, size * sizeof(T)) != 0) {
+            close(descriptor);
+            ThrowSystemError("MappedArray::CreateTemporary", path);
+        }
+        return MappedArray("", descriptor, size);
+    }
+
+    template <typename T>
+    MappedArray<T>::MappedArray(MappedArray&& other) noexcept
+        : path_(std::move(other.path_)), descriptor_(other.descriptor_),
+          data_(other.data_), size_(other.size_) {
+        other.descriptor_ = -1;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    template <typename T>
+    MappedArray<T>& MappedArray<T>::operator=(MappedArray&& other) noexcept {
+        if (this != &other) {
+            Close();
+            path_ = std::move(other.path_);
+            descriptor_ = other.descriptor_;
+            data_ = other.data_;
+            size_ = other.size_;
+            other.descriptor_ = -1;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    template <typename T>
+    MappedArray<T>::~MappedArray() {
+        Close();
+    }
+
+    template <typename T>
+    void MappedArray<T>::Close() {
+        if (data_ != nullptr) {
+            munmap(data_, size_ * sizeof(T));
+            data_ = nullptr;
+        }
+        if (descriptor_ >= 0) {
+            close(descriptor_);
+            descriptor_ = -1;
+        }
+    }
+
+    MappedFile::MappedFile(const std::string& path)
+        : path_(path) {
+        int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            ThrowSystemError("MappedFile", path);
+        }
+        struct stat file_stat;
+        if (fstat(descriptor, &file_stat) != 0) {
+            close(descriptor);
+            ThrowSystemError("MappedFile", path);
+        }
+        size_ = file_stat.st_size;
+
+        //пустой файл отобразить нельзя, он остается с data_ == nullptr
+        if (size_ > 0) {
+            void* address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address == MAP_FAILED) {
+                close(descriptor);
+                ThrowSystemError("MappedFile", path);
+            }
+            //файлы обычно читаются подряд, пусть ядро читает наперед
+            madvise(address, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(address);
+        }
+        close(descriptor);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : path_(std::move(other.path_)), data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            path_ = std::move(other.path_);
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+    void MappedFile::Close() {
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+        }
+    }
+
+    template <typename T>
+    void TransposePanels(const T* src, T* dst, size_t rows, size_t cols) {
+        //столбец панели из height элементов занимает целую страницу dst
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t height = std::min(rows, std::max<size_t>(1, page / sizeof(T)));
+        //панель режется по столбцам на куски height x width, помещающиеся в kPanelBytes
+        size_t width = std::min(cols, std::max<size_t>(1, kPanelBytes / (height * sizeof(T))));
+
+        std::vector<T> block(height * width), transposed(height * width);
+        for (size_t row_begin = 0; row_begin < rows; row_begin += height) {
+            size_t panel_height = std::min(height, rows - row_begin);
+            for (size_t col_begin = 0; col_begin < cols; col_begin += width) {
+                size_t block_width = std::min(width, cols - col_begin);
+                for (size_t row = 0; row < panel_height; ++row) {
+                    const T* begin = src + (row_begin + row) * cols + col_begin;
+                    std::copy(begin, begin + block_width, block.data() + row * block_width);
+                }
+                FFT::Transpose(block.data(), transposed.data(), panel_height, block_width);
+                for (size_t col = 0; col < block_width; ++col) {
+                    const T* begin = transposed.data() + col * panel_height;
+                    std::copy(begin, begin + panel_height,
+                              dst + (col_begin + col) * rows + row_begin);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void FastFourierTransform(MappedArray<T>& data, const std::string& scratch_directory) {
+        MappedArray<T> buffer = MappedArray<T>::CreateTemporary(scratch_directory, data.Size());
+        FFT::SixStepTransform(data.Data(), buffer.Data(), data.Size(), false, TransposePanels<T>);
+    }
+
+    template <typename T>
+    void FastInverseFourierTransform(MappedArray<T>& data, const std::string& scratch_directory) {
+        MappedArray<T> buffer = MappedArray<T>::CreateTemporary(scratch_directory, data.Size());
+        FFT::SixStepTransform(data.Data(), buffer.Data(), data.Size(), true, TransposePanels<T>);
+    }
+
+    template <typename T>
+    MappedArray<T> MultiplyPolynomials(const MappedArray<T>& first,
+                                       const MappedArray<T>& second,
+                                       const std::string& result_path,
+                                       const std::string& scratch_directory) {
+        size_t future_degree = first.Size() + second.Size() - 1;
+
+        size_t new_deg = 1;
+        while (new_deg < future_degree) {
+            new_deg *= 2;
+        }
+
+        //дополняем нулями во временных файлах, исходные файлы не трогаем
+        MappedArray<T> first_values = MappedArray<T>::CreateTemporary(scratch_directory, new_deg);
+        std::copy(first.Data(), first.Data() + first.Size(), first_values.Data());
+        FastFourierTransform(first_values, scratch_directory);
+
+        {
+            MappedArray<T> second_values =
+                MappedArray<T>::CreateTemporary(scratch_directory, new_deg);
+            std::copy(second.Data(), second.Data() + second.Size(), second_values.Data());
+            FastFourierTransform(second_values, scratch_directory);
+
+            //поточечное произведение - один последовательный проход по обоим файлам
+            for (size_t i = 0; i < new_deg; ++i) {
+                first_values[i] *= second_values[i];
+            }
+        }
+
+        FastInverseFourierTransform(first_values, scratch_directory);
+
+        MappedArray<T> result = MappedArray<T>::Create(result_path, future_degree);
+        std::copy(first_values.Data(), first_values.Data() + future_degree, result.Data());
+        return result;
+    }
+
+
+    template class MappedArray<std::complex<float>>;
+    template class MappedArray<std::complex<double>>;
+    template class MappedArray<std::complex<long double>>;
+
+    template void TransposePanels(const std::complex<float>* src, std::complex<float>* dst,
+                                  size_t rows, size_t cols);
+    template void TransposePanels(const std::complex<double>* src, std::complex<double>* dst,
+                                  size_t rows, size_t cols);
+    template void TransposePanels(const std::complex<long double>* src,
+                                  std::complex<long double>* dst, size_t rows, size_t cols);
+
+    template void FastFourierTransform(MappedArray<std::complex<float>>& data,
+                                       const std::string& scratch_directory);
+    template void FastFourierTransform(MappedArray<std::complex<double>>& data,
+                                       const std::string& scratch_directory);
+    template void FastFourierTransform(MappedArray<std::complex<long double>>& data,
+                                       const std::string& scratch_directory);
+
+    template void FastInverseFourierTransform(MappedArray<std::complex<float>>& data,
+                                              const std::string& scratch_directory);
+    template void FastInverseFourierTransform(MappedArray<std::complex<double>>& data,
+                                              const std::string& scratch_directory);
+    template void FastInverseFourierTransform(MappedArray<std::complex<long double>>& data,
+                                              const std::string& scratch_directory);
+
+    template MappedArray<std::complex<float>>
+    MultiplyPolynomials(const MappedArray<std::complex<float>>& first,
+                        const MappedArray<std::complex<float>>& second,
+                        const std::string& result_path, const std::string& scratch_directory);
+    template MappedArray<std::complex<double>>
+    MultiplyPolynomials(const MappedArray<std::complex<double>>& first,
+                        const MappedArray<std::complex<double>>& second,
+                        const std::string& result_path, const std::string& scratch_directory);
+    template MappedArray<std::complex<long double>>
+    MultiplyPolynomials(const MappedArray<std::complex<long double>>& first,
+                        const MappedArray<std::complex<long double>>& second,
+                        const std::string& result_path, const std::string& scratch_directory);
+}
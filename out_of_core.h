@@ -0,0 +1,145 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <complex>
+#include <string_view>
+
+// Преобразование Фурье и умножение многочленов, данные которых не помещаются
+// в оперативную память: коэффициенты и спектры лежат в отображенных в память файлах
+// в виде сырого массива элементов типа T
+namespace OutOfCore {
+// Массив элементов типа T, хранящийся в отображенном в память файле
+template <typename T>
+class MappedArray {
+ public:
+  // Создает файл path под size элементов, заполненных нулями
+  static MappedArray Create(const std::string& path, size_t size);
+
+  // Отображает в память существующий файл с элементами,
+  // бросает std::runtime_error, если размер файла не кратен sizeof(T)
+  static MappedArray Open(const std::string& path);
+
+  // Создает безымянный рабочий файл в каталоге directory,
+  // файл удаляется вместе с отображением
+  static MappedArray CreateTemporary(const std::string& directory, size_t size);
+
+  MappedArray(const MappedArray&) = delete;
+  MappedArray(MappedArray&& other) noexcept;
+
+  MappedArray& operator=(const MappedArray&) = delete;
+  MappedArray& operator=(MappedArray&& other) noexcept;
+
+  ~MappedArray();
+
+  T* Data() {
+      return data_;
+  }
+
+  const T* Data() const {
+      return data_;
+  }
+
+  size_t Size() const {
+      return size_;
+  }
+
+  T& operator[](size_t index) {
+      return data_[index];
+  }
+
+  const T& operator[](size_t index) const {
+      return data_[index];
+  }
+
+  const std::string& GetPath() const {
+      return path_;
+  }
+
+ private:
+  MappedArray(std::string path, int descriptor, size_t size);
+
+  void Close();
+
+  std::string path_;
+  int descriptor_ = -1;
+  T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Файл, отображенный в память только для чтения. Дескриптор закрывается сразу
+// после отображения, поэтому одновременно можно держать много файлов
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  ~MappedFile();
+
+  const char* Data() const {
+      return data_;
+  }
+
+  size_t Size() const {
+      return size_;
+  }
+
+  std::string_view View() const {
+      return {data_, size_};
+  }
+
+  const std::string& GetPath() const {
+      return path_;
+  }
+
+ private:
+  void Close();
+
+  std::string path_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Транспонирование матрицы rows x cols из src в dst, лежащих в отображенных файлах.
+// Плитки 32 x 32 на всю матрицу трогают каждую страницу dst много раз вразброс,
+// поэтому src читается панелями по height строк, где height элементов занимают
+// страницу, панель транспонируется в памяти, и каждый ее столбец пишется в dst
+// одним отрезком в целую страницу: каждая страница src и dst читается или
+// пишется один раз, а src идет подряд
+template <typename T>
+void TransposePanels(const T* src, T* dst, size_t rows, size_t cols);
+
+// Быстрое преобразование Фурье на месте для массива длины 2^k,
+// проходы шестишагового алгоритма читают и пишут файлы блоками, транспонирования
+// идут через TransposePanels, рабочий файл того же размера создается
+// в каталоге scratch_directory
+template <typename T>
+void FastFourierTransform(MappedArray<T>& data, const std::string& scratch_directory);
+
+// Обратное преобразование на месте для массива длины 2^k
+template <typename T>
+void FastInverseFourierTransform(MappedArray<T>& data, const std::string& scratch_directory);
+
+// Умножает многочлены с коэффициентами из first и second,
+// результат записывается в файл result_path
+template <typename T>
+MappedArray<T> MultiplyPolynomials(const MappedArray<T>& first,
+                                   const MappedArray<T>& second,
+                                   const std::string& result_path,
+                                   const std::string& scratch_directory);
+
+//Тесты
+void TestMappedArray();
+void TestMappedFile();
+void TestTransposePanels();
+void TestFastFourierTransform();
+void TestMultiplyPolynomials();
+} // namespace OutOfCore
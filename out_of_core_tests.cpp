@@ -0,0 +1,154 @@
+#include "out_of_core.h"
+#include "fft.h"
+#include "polynomial.h"
+#include "test_runner.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace OutOfCore {
+void TestMappedArray() {
+    using std::complex;
+
+    const std::string directory = std::filesystem::temp_directory_path().string();
+    const std::string path = directory + "/fft_mapped_array_test";
+
+    {
+        MappedArray<complex<double>> array = MappedArray<complex<double>>::Create(path, 4);
+        ASSERT_EQUAL(array.Size(), 4u);
+        ASSERT_EQUAL(array[3], complex<double>(0));
+        array[1] = {1, 2};
+    }
+    {
+        MappedArray<complex<double>> array = MappedArray<complex<double>>::Open(path);
+        ASSERT_EQUAL(array.Size(), 4u);
+        ASSERT_EQUAL(array[1], complex<double>(1, 2));
+    }
+    //три complex<float> не делятся на complex<double>
+    MappedArray<complex<float>>::Create(path, 3);
+    {
+        bool thrown = false;
+        try {
+            MappedArray<complex<double>>::Open(path);
+        } catch (std::runtime_error&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+    std::filesystem::remove(path);
+
+    MappedArray<complex<float>> scratch =
+        MappedArray<complex<float>>::CreateTemporary(directory, 8);
+    ASSERT_EQUAL(scratch.Size(), 8u);
+    ASSERT(scratch.GetPath().empty());
+}
+
+void TestMappedFile() {
+    const std::string path =
+        std::filesystem::temp_directory_path().string() + "/fft_mapped_file_test";
+
+    {
+        std::ofstream file(path);
+        file << "hello, mapped file";
+    }
+    {
+        MappedFile file(path);
+        ASSERT_EQUAL(file.Size(), 18u);
+        ASSERT_EQUAL(std::string(file.View()), "hello, mapped file");
+
+        MappedFile moved = std::move(file);
+        ASSERT_EQUAL(moved.View().substr(7, 6), "mapped");
+        ASSERT(file.Data() == nullptr);
+    }
+
+    std::ofstream(path, std::ios::trunc).close();
+    ASSERT_EQUAL(MappedFile(path).Size(), 0u);
+    std::filesystem::remove(path);
+
+    bool thrown = false;
+    try {
+        MappedFile missing(path);
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+
+void TestTransposePanels() {
+    using std::complex;
+    using std::vector;
+
+    //панели выше и ниже матрицы, неполные последние панель и кусок
+    for (auto [rows, cols] : vector<std::pair<size_t, size_t>>{{700, 37}, {3, 1000}, {1024, 1024}}) {
+        vector<complex<double>> matrix(rows * cols), expected(rows * cols), result(rows * cols);
+        for (size_t i = 0; i < matrix.size(); ++i) {
+            matrix[i] = complex<double>(double(i), -double(i % 7));
+        }
+        FFT::Transpose(matrix.data(), expected.data(), rows, cols);
+        TransposePanels(matrix.data(), result.data(), rows, cols);
+        ASSERT_EQUAL(result, expected);
+    }
+}
+
+void TestFastFourierTransform() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-5;
+    const std::string directory = std::filesystem::temp_directory_path().string();
+
+    vector<complex<long double>> v1(512);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = complex<long double>(i % 11, 0);
+    }
+
+    MappedArray<complex<long double>> array =
+        MappedArray<complex<long double>>::CreateTemporary(directory, v1.size());
+    std::copy(begin(v1), end(v1), array.Data());
+
+    FastFourierTransform(array, directory);
+    ASSERT_VECTOR(vector<complex<long double>>(array.Data(), array.Data() + array.Size()),
+                  FFT::FastFourierTransform(v1), error);
+
+    FastInverseFourierTransform(array, directory);
+    ASSERT_VECTOR(vector<complex<long double>>(array.Data(), array.Data() + array.Size()),
+                  v1, error);
+}
+
+void TestMultiplyPolynomials() {
+    using std::complex;
+    using std::vector;
+
+    const std::string directory = std::filesystem::temp_directory_path().string();
+    const std::string result_path = directory + "/fft_multiply_test";
+
+    vector<complex<double>> v1 = {7, 2, 13, 6}, v2 = {3, 1, 0, 0, 5, 8, 9};
+
+    MappedArray<complex<double>> first =
+        MappedArray<complex<double>>::CreateTemporary(directory, v1.size());
+    MappedArray<complex<double>> second =
+        MappedArray<complex<double>>::CreateTemporary(directory, v2.size());
+    std::copy(begin(v1), end(v1), first.Data());
+    std::copy(begin(v2), end(v2), second.Data());
+
+    MappedArray<complex<double>> result =
+        MultiplyPolynomials(first, second, result_path, directory);
+
+    ASSERT_EQUAL(
+        Polynomial(vector<complex<double>>(result.Data(), result.Data() + result.Size())),
+        Polynomial<complex<double>>({21, 13, 41, 31, 41, 66, 144, 152, 165, 54})
+    );
+
+    //то же через Polynomial
+    const std::string polynomial_path = result_path + "_polynomial";
+    MappedArray<complex<double>> product =
+        Polynomial<complex<double>>::MultiplyMapped(second, first, polynomial_path, directory);
+    ASSERT_EQUAL(
+        Polynomial(vector<complex<double>>(product.Data(), product.Data() + product.Size())),
+        Polynomial<complex<double>>({21, 13, 41, 31, 41, 66, 144, 152, 165, 54})
+    );
+
+    std::filesystem::remove(result_path);
+    std::filesystem::remove(polynomial_path);
+}
+} // namespace OutOfCore
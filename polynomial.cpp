@@ -1,5 +1,225 @@
 #include "polynomial.h"
 #include "fft.h"
+#include "instrumentation.h"
+#include "accuracy.h"
+#include "thread_pool.h"
+#include "integer_multiplication.h"
+#include "out_of_core.h"
+
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace {
+//узлы, покрывающие не больше стольких точек, считаются схемой Горнера
+const size_t kNaiveEvaluationSize = 32;
+
+//если у одного из множителей не больше стольких коэффициентов,
+//умножение в столбик быстрее преобразований
+const size_t kNaiveMultiplicationSize = 32;
+
+//Значение многочлена с коэффициентами coefficients в точке point по схеме Горнера
+template <typename T>
+T EvaluateHorner(const std::vector<T>& coefficients, const T& point) {
+    T value = 0;
+    for (size_t k = coefficients.size(); k > 0; --k) {
+        value = value * point + coefficients[k - 1];
+    }
+    return value;
+}
+
+//Интерполяция за O(n^2): разделенные разности Ньютона раскрываются
+//по схеме Горнера в коэффициенты
+template <typename T>
+std::vector<T> InterpolateNewton(const std::vector<T>& points, std::vector<T> differences) {
+    size_t size = points.size();
+    for (size_t k = 1; k < size; ++k) {
+        for (size_t i = size - 1; i >= k; --i) {
+            differences[i] = (differences[i] - differences[i - 1]) / (points[i] - points[i - k]);
+        }
+    }
+
+    //f(x) = d_0 + (x - x_0) * (d_1 + (x - x_1) * (...))
+    std::vector<T> result(size);
+    for (size_t k = size; k > 0; --k) {
+        for (size_t j = size - 1; j > 0; --j) {
+            result[j] = result[j - 1] - points[k - 1] * result[j];
+        }
+        result[0] = differences[k - 1] - points[k - 1] * result[0];
+    }
+    return result;
+}
+
+//Деление в столбик за O((n - m + 1) * m): dividend превращается в остаток,
+//возвращаются коэффициенты частного
+template <typename T>
+std::vector<T> DivideLong(std::vector<T>& dividend, const std::vector<T>& divisor) {
+    size_t divisor_size = divisor.size();
+    std::vector<T> quotient(dividend.size() - divisor_size + 1);
+    for (size_t k = quotient.size(); k > 0; --k) {
+        T coefficient = dividend[k + divisor_size - 2] / divisor.back();
+        quotient[k - 1] = coefficient;
+        for (size_t j = 0; j < divisor_size; ++j) {
+            dividend[k - 1 + j] -= coefficient * divisor[j];
+        }
+    }
+    return quotient;
+}
+
+template <typename T>
+Polynomial<T> MultiplyNaive(const Polynomial<T>& first, const Polynomial<T>& second) {
+    std::vector<T> first_coefficients = first.GetCoefficients();
+    std::vector<T> second_coefficients = second.GetCoefficients();
+    //у произведения с пустым множителем коэффициентов нет
+    if (first_coefficients.empty() || second_coefficients.empty()) {
+        return Polynomial<T>(std::vector<T>());
+    }
+
+    std::vector<T> result(first_coefficients.size() + second_coefficients.size() - 1);
+    for (size_t i = 0; i < first_coefficients.size(); ++i) {
+        for (size_t j = 0; j < second_coefficients.size(); ++j) {
+            result[i + j] += first_coefficients[i] * second_coefficients[j];
+        }
+    }
+    return Polynomial<T>(result);
+}
+
+//Дерево подпроизведений: на уровне 0 лежат многочлены x - x_i,
+//узел j уровня k - произведение узлов 2j и 2j + 1 уровня k - 1
+//и покрывает точки [j * 2^k, (j + 1) * 2^k)
+template <typename T>
+class SubproductTree {
+ public:
+  using Real = typename T::value_type;
+
+  explicit SubproductTree(const std::vector<T>& points)
+      : points_(points) {
+      std::vector<Polynomial<T>> leaves;
+      leaves.reserve(points.size());
+      for (const T& point : points) {
+          leaves.push_back(Polynomial<T>({-point, T(1)}));
+      }
+      levels_.push_back(std::move(leaves));
+
+      //узлы одного уровня независимы, строим их параллельно
+      while (levels_.back().size() > 1) {
+          const std::vector<Polynomial<T>>& lower = levels_.back();
+          std::vector<Polynomial<T>> upper(
+              (lower.size() + 1) / 2, Polynomial<T>(std::vector<T>())
+          );
+          GetDefaultThreadPool().ParallelFor(0, upper.size(), [&lower, &upper](size_t j) {
+              upper[j] = 2 * j + 1 < lower.size() ? lower[2 * j] * lower[2 * j + 1] : lower[2 * j];
+          });
+          levels_.push_back(std::move(upper));
+      }
+
+      //остаток от деления на узел с большими коэффициентами теряет точность
+      //пропорционально им, поэтому перемножаем max |коэффициент| по уровням, на узлы
+      //которых делятся остатки: от узлов из kNaiveEvaluationSize точек до корня.
+      //Узел с коэффициентами не больше 1 ошибку не усиливает, а лишь добавляет
+      //свои eps, поэтому множитель уровня не меньше 1, но и не 1 + max
+      for (size_t level = 0; level < levels_.size(); ++level) {
+          if ((size_t(1) << level) < kNaiveEvaluationSize && level + 1 < levels_.size()) {
+              continue;
+          }
+          Real norm = 0;
+          for (const Polynomial<T>& node : levels_[level]) {
+              for (const T& coefficient : node.GetCoefficients()) {
+                  norm = std::max(norm, std::abs(coefficient));
+              }
+          }
+          growth_ *= std::max(Real(1), norm);
+      }
+  }
+
+  const Polynomial<T>& GetRoot() const {
+      return levels_.back()[0];
+  }
+
+  //Погрешность Evaluate и LinearCombination относительно значений порядка
+  //eps * log2(k) * growth^2. Для корней из 1 в бит-реверсном порядке (и их
+  //кратных r * w^j, |r| <= 1) узлы - это x^m - c с |c| <= 1 и growth = 1 при
+  //любом числе точек. Для действительных точек коэффициенты узлов растут
+  //экспоненциально от их размера (матрица Вандермонда плохо обусловлена),
+  //и дерево неустойчиво уже на сотне точек. Дерево точно, пока оценка
+  //не больше sqrt(eps), или, что то же, growth не больше eps^(-1/4)
+  bool IsStable() const {
+      return growth_ <= std::pow(std::numeric_limits<Real>::epsilon(), Real(-0.25));
+  }
+
+  std::vector<T> Evaluate(const Polynomial<T>& polynomial) const {
+      std::vector<T> result(points_.size());
+
+      std::vector<Polynomial<T>> remainders = {polynomial % GetRoot()};
+      for (size_t level = levels_.size() - 1; level > 0; --level) {
+          size_t covered = size_t(1) << level;
+          if (covered <= kNaiveEvaluationSize) {
+              GetDefaultThreadPool().ParallelFor(
+                  0, remainders.size(), [this, &remainders, &result, covered](size_t j) {
+                      EvaluateNaive(remainders[j], j * covered, covered, result);
+                  });
+              return result;
+          }
+
+          const std::vector<Polynomial<T>>& lower = levels_[level - 1];
+          std::vector<Polynomial<T>> next(lower.size(), Polynomial<T>(std::vector<T>()));
+          GetDefaultThreadPool().ParallelFor(
+              0, lower.size(), [&lower, &remainders, &next](size_t j) {
+                  next[j] = remainders[j / 2] % lower[j];
+              });
+          remainders = std::move(next);
+      }
+
+      //остаток от деления на x - x_i - это значение в x_i
+      for (size_t i = 0; i < remainders.size(); ++i) {
+          EvaluateNaive(remainders[i], i, 1, result);
+      }
+      return result;
+  }
+
+  //sum_i weights[i] * M(x) / (x - x_i), где M - произведение всех x - x_i
+  Polynomial<T> LinearCombination(const std::vector<T>& weights) const {
+      std::vector<Polynomial<T>> combinations;
+      combinations.reserve(weights.size());
+      for (const T& weight : weights) {
+          combinations.push_back(Polynomial<T>({weight}));
+      }
+
+      for (size_t level = 0; level + 1 < levels_.size(); ++level) {
+          const std::vector<Polynomial<T>>& nodes = levels_[level];
+          std::vector<Polynomial<T>> upper(
+              (combinations.size() + 1) / 2, Polynomial<T>(std::vector<T>())
+          );
+          GetDefaultThreadPool().ParallelFor(
+              0, upper.size(), [&nodes, &combinations, &upper](size_t j) {
+                  if (2 * j + 1 < nodes.size()) {
+                      upper[j] = combinations[2 * j] * nodes[2 * j + 1] +
+                                 combinations[2 * j + 1] * nodes[2 * j];
+                  } else {
+                      upper[j] = combinations[2 * j];
+                  }
+              });
+          combinations = std::move(upper);
+      }
+      return combinations[0];
+  }
+
+ private:
+  void EvaluateNaive(const Polynomial<T>& polynomial, size_t begin, size_t count,
+                     std::vector<T>& result) const {
+      std::vector<T> coefficients = polynomial.GetCoefficients();
+      size_t end = std::min(begin + count, points_.size());
+      for (size_t i = begin; i < end; ++i) {
+          result[i] = EvaluateHorner(coefficients, points_[i]);
+      }
+  }
+
+  std::vector<T> points_;
+  std::vector<std::vector<Polynomial<T>>> levels_;
+  //произведение 1 + max |коэффициент| по уровням, см. IsStable
+  Real growth_ = 1;
+};
+}
 
 template <typename T>
 bool Polynomial<T>::operator==(const Polynomial& other) const {
@@ -9,6 +229,14 @@ bool Polynomial<T>::operator==(const Polynomial& other) const {
     size_t min_ = std::min(degree_, other.degree_);
     size_t max_ = std::max(degree_, other.degree_);
 
+    if (Accuracy::IsEnabled()) {
+        Accuracy::Record("Polynomial::operator==", min_, std::max(
+            Accuracy::MaxDistanceToInteger(begin(coefficients_), begin(coefficients_) + min_),
+            Accuracy::MaxDistanceToInteger(begin(other.coefficients_),
+                                           begin(other.coefficients_) + min_)
+        ), NAN);
+    }
+
     //значения в коэффициентах при маленьких степенях должны совпадать
     for (size_t i = 0; i < min_; ++i) {
         if (std::round(std::real(coefficients_[i])) !=
@@ -55,7 +283,16 @@ Polynomial<T>& Polynomial<T>::operator+=(const Polynomial<T>& other) {
 
 template <typename T>
 Polynomial<T>& Polynomial<T>::operator-=(const Polynomial<T>& other) {
-    return *this += -other;
+    //то же, что и operator+=, но без временного многочлена -other
+    size_t max_ = std::max(degree_, other.degree_);
+
+    coefficients_.resize(max_, T(0));
+    for (size_t i = 0; i < other.degree_; ++i) {
+        coefficients_[i] -= other.coefficients_[i];
+    }
+
+    degree_ = max_;
+    return *this;
 }
 
 template <typename T>
@@ -69,26 +306,55 @@ Polynomial<T>& Polynomial<T>::operator*=(const Polynomial& other) {
 
     new_deg *= 2;
 
-    std::vector<T> this_values =
-        FFT::FastFourierTransform(FFT::AddPadding<T>(coefficients_, new_deg));
-    std::vector<T> other_values =
-        FFT::FastFourierTransform(FFT::AddPadding<T>(other.coefficients_, new_deg));
+    INSTRUMENT_SCOPE("Polynomial::operator*=", T, new_deg);
+
+    //в режиме контроля точности оценку погрешности считаем по множителям,
+    //а расстояние до целых имеет смысл, только если множители целые
+    bool check_accuracy = Accuracy::IsEnabled();
+    bool integral = false;
+    double error_bound = 0;
+    if (check_accuracy) {
+        integral = Accuracy::IsIntegral(coefficients_) && Accuracy::IsIntegral(other.coefficients_);
+        error_bound = Accuracy::ConvolutionErrorBound(coefficients_, other.coefficients_, new_deg);
+    }
+
+    std::vector<T> this_values, other_values;
+    {
+        INSTRUMENT_SCOPE("Polynomial::operator*= forward", T, new_deg);
+        this_values = FFT::FastFourierTransform(FFT::AddPadding<T>(coefficients_, new_deg));
+        other_values = FFT::FastFourierTransform(FFT::AddPadding<T>(other.coefficients_, new_deg));
+    }
 
     std::vector<T> multiply_values(new_deg);
-    for (size_t i = 0; i < new_deg; ++i) {
-        multiply_values[i] = this_values[i] * other_values[i];
+    {
+        INSTRUMENT_SCOPE("Polynomial::operator*= pointwise", T, new_deg);
+        for (size_t i = 0; i < new_deg; ++i) {
+            multiply_values[i] = this_values[i] * other_values[i];
+        }
     }
 
-    *this = Polynomial(FFT::FastInverseFourierTransform(multiply_values));
+    {
+        INSTRUMENT_SCOPE("Polynomial::operator*= inverse", T, new_deg);
+        *this = Polynomial(FFT::FastInverseFourierTransform(multiply_values));
+    }
 
     degree_ = future_degree;
     coefficients_.resize(degree_);
 
+    if (check_accuracy) {
+        Accuracy::Record("Polynomial::operator*=", new_deg,
+                         integral ? Accuracy::MaxDistanceToInteger(begin(coefficients_),
+                                                                   end(coefficients_))
+                                  : NAN,
+                         error_bound);
+    }
+
     return *this;
 }
 
 template <typename T>
 Polynomial<T>& Polynomial<T>::operator^=(size_t pow) {
+    INSTRUMENT_SCOPE("Polynomial::operator^=", T, degree_);
     if (pow == 0) {
         *this = Polynomial({1});
         return *this;
@@ -122,6 +388,384 @@ Polynomial<T>& Polynomial<T>::operator^=(size_t pow) {
     }
 }
 
+template <typename T>
+Polynomial<T>& Polynomial<T>::operator/=(const Polynomial& other) {
+    *this = Divide(other, nullptr);
+    return *this;
+}
+
+template <typename T>
+Polynomial<T>& Polynomial<T>::operator%=(const Polynomial& other) {
+    //короткое делимое Divide вернет остатком без изменений, но сначала проверит делитель
+    Divide(other, this);
+    return *this;
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::Divide(const Polynomial& other, Polynomial* remainder) const {
+    using Real = typename T::value_type;
+    const Real epsilon = std::numeric_limits<Real>::epsilon();
+
+    //старший коэффициент, сравнимый с ошибкой округления остальных, все равно что ноль
+    Real divisor_scale = 0;
+    for (const T& coefficient : other.coefficients_) {
+        divisor_scale = std::max(divisor_scale, std::abs(coefficient));
+    }
+    if (other.degree_ == 0 || std::abs(other.coefficients_.back()) <= epsilon * divisor_scale) {
+        std::ostringstream os;
+        os << "Exception thrown in Polynomial::operator/=,"
+              " leading coefficient of divisor is zero\n";
+        throw std::runtime_error(os.str());
+    }
+
+    if (degree_ < other.degree_) {
+        if (remainder != nullptr) {
+            *remainder = *this;
+        }
+        return Polynomial({0});
+    }
+    INSTRUMENT_SCOPE("Polynomial::operator/=", T, degree_);
+
+    //если развернуть коэффициенты, то a(x) = b(x) q(x) + r(x) превращается в
+    //rev(a) = rev(b) rev(q) + x^(n - m + 1) rev(r), поэтому
+    //rev(q) = rev(a) / rev(b) mod x^(n - m + 1)
+    size_t quotient_degree = degree_ - other.degree_ + 1;
+
+    Polynomial reversed_this(std::vector<T>(rbegin(coefficients_), rend(coefficients_)));
+    Polynomial reversed_other(
+        std::vector<T>(rbegin(other.coefficients_), rend(other.coefficients_))
+    );
+    reversed_this.Resize(quotient_degree);
+
+    reversed_this *= reversed_other.Inverse(quotient_degree);
+    reversed_this.Resize(quotient_degree);
+
+    Polynomial quotient(std::vector<T>(rbegin(reversed_this.coefficients_),
+                                       rend(reversed_this.coefficients_)));
+
+    //коэффициенты обратного ряда могут расти и сокращаться, тогда частное неверно
+    //без всякой ошибки, поэтому проверяем, что старшие коэффициенты a - q * b
+    //сократились, а если нет - делим в столбик
+    Polynomial rest = *this - quotient * other;
+    Real scale = 0, residual = 0;
+    for (size_t i = 0; i < degree_; ++i) {
+        scale = std::max(scale, std::abs(coefficients_[i]));
+    }
+    for (size_t i = other.degree_ - 1; i < rest.degree_; ++i) {
+        residual = std::max(residual, std::abs(rest.coefficients_[i]));
+    }
+    if (!(residual <= std::sqrt(epsilon) * scale)) {
+        std::vector<T> rest_coefficients = coefficients_;
+        quotient = Polynomial(DivideLong(rest_coefficients, other.coefficients_));
+        rest = Polynomial(rest_coefficients);
+    }
+
+    if (remainder != nullptr) {
+        //старшие коэффициенты сократились, остаток короче делителя
+        rest.Resize(std::max<size_t>(other.degree_ - 1, 1));
+        *remainder = std::move(rest);
+    }
+    return quotient;
+}
+
+template <typename T>
+const Polynomial<T> Polynomial<T>::Inverse(size_t n) const {
+    if (degree_ == 0 || coefficients_[0] == T(0)) {
+        std::ostringstream os;
+        os << "Exception thrown in Polynomial::Inverse, constant term is zero\n";
+        throw std::runtime_error(os.str());
+    }
+
+    Polynomial result({T(1) / coefficients_[0]});
+    size_t length = 1;
+
+    while (length < n) {
+        length *= 2;
+
+        //g <- g * (2 - f * g) mod x^length
+        Polynomial correction = -MultiplyLow(result, length);
+        correction.coefficients_[0] += T(2);
+
+        result = result.MultiplyLow(correction, length);
+    }
+
+    result.Resize(n);
+    return result;
+}
+
+template <typename T>
+const Polynomial<T> Polynomial<T>::MultiplyLow(const Polynomial& other, size_t n) const {
+    //старшие коэффициенты множителей на первые n коэффициентов не влияют
+    Polynomial first = *this;
+    Polynomial second = other;
+    first.Resize(std::min(degree_, n));
+    second.Resize(std::min(other.degree_, n));
+
+    Polynomial result = std::min(first.degree_, second.degree_) <= kNaiveMultiplicationSize
+                        ? MultiplyNaive(first, second)
+                        : first * second;
+    result.Resize(n);
+    return result;
+}
+
+template <typename T>
+const Polynomial<T> Polynomial<T>::MultiplyExact(const Polynomial& other) const {
+    //2^63 точно представимо в любой точности, а значения от него и выше в int64_t не входят
+    const typename T::value_type limit = std::ldexp(typename T::value_type(1), 63);
+    auto to_integers = [limit](const std::vector<T>& coefficients) {
+        std::vector<int64_t> result(coefficients.size());
+        for (size_t i = 0; i < coefficients.size(); ++i) {
+            auto value = std::real(coefficients[i]);
+            if (std::imag(coefficients[i]) != 0 || value != std::round(value) ||
+                value < -limit || value >= limit) {
+                std::ostringstream os;
+                os << "Exception thrown in Polynomial::MultiplyExact, coefficient "
+                   << coefficients[i] << " is not a 64-bit integer\n";
+                throw std::runtime_error(os.str());
+            }
+            result[i] = static_cast<int64_t>(value);
+        }
+        return result;
+    };
+
+    std::vector<__int128> product = IntegerMultiplication::MultiplyExact(
+        to_integers(coefficients_), to_integers(other.coefficients_));
+
+    std::vector<T> result(product.size());
+    for (size_t i = 0; i < product.size(); ++i) {
+        result[i] = static_cast<typename T::value_type>(product[i]);
+    }
+    return Polynomial(result);
+}
+
+template <typename T>
+OutOfCore::MappedArray<T> Polynomial<T>::MultiplyMapped(const OutOfCore::MappedArray<T>& first,
+                                                        const OutOfCore::MappedArray<T>& second,
+                                                        const std::string& result_path,
+                                                        const std::string& scratch_directory) {
+    return OutOfCore::MultiplyPolynomials(first, second, result_path, scratch_directory);
+}
+
+template <typename T>
+const Polynomial<T> Polynomial<T>::Log(size_t n) const {
+    if (degree_ == 0 || coefficients_[0] != T(1)) {
+        std::ostringstream os;
+        os << "Exception thrown in Polynomial::Log, constant term is not one\n";
+        throw std::runtime_error(os.str());
+    }
+
+    //log f = integral(f' / f)
+    Polynomial result = Derivative().MultiplyLow(Inverse(n), n).Integral();
+    result.Resize(n);
+    return result;
+}
+
+template <typename T>
+const Polynomial<T> Polynomial<T>::Exp(size_t n) const {
+    if (degree_ != 0 && coefficients_[0] != T(0)) {
+        std::ostringstream os;
+        os << "Exception thrown in Polynomial::Exp, constant term is not zero\n";
+        throw std::runtime_error(os.str());
+    }
+
+    Polynomial result({1});
+    size_t length = 1;
+
+    while (length < n) {
+        length *= 2;
+
+        //g <- g * (1 - log g + f) mod x^length; свободный член exp f равен
+        //единице точно, а умножение через ффт сдвигает его на ulp, и Log бы упал
+        result.coefficients_[0] = T(1);
+        Polynomial correction = *this;
+        correction.Resize(std::min(length, degree_));
+        correction -= result.Log(length);
+        correction.coefficients_[0] += T(1);
+
+        result = result.MultiplyLow(correction, length);
+    }
+
+    result.Resize(n);
+    return result;
+}
+
+template <typename T>
+const Polynomial<T> Polynomial<T>::Sqrt(size_t n) const {
+    if (degree_ == 0 || coefficients_[0] == T(0)) {
+        std::ostringstream os;
+        os << "Exception thrown in Polynomial::Sqrt, constant term is zero\n";
+        throw std::runtime_error(os.str());
+    }
+
+    Polynomial result({std::sqrt(coefficients_[0])});
+    size_t length = 1;
+
+    while (length < n) {
+        length *= 2;
+
+        //g <- (g + f / g) / 2 mod x^length
+        Polynomial quotient = MultiplyLow(result.Inverse(length), length);
+        result += quotient;
+        result.Resize(length);
+        for (auto& coefficient : result.coefficients_) {
+            coefficient /= T(2);
+        }
+    }
+
+    result.Resize(n);
+    return result;
+}
+
+template <typename T>
+const Polynomial<T> Polynomial<T>::PowMod(size_t pow, size_t n) const {
+    //то же индийское возведение в степень, что и в operator^=,
+    //но каждое произведение обрезается до n коэффициентов
+    Polynomial result({1});
+    Polynomial base = *this;
+    base.Resize(std::min(degree_, n));
+
+    while (pow > 0) {
+        if (pow % 2 == 1) {
+            result = result.MultiplyLow(base, n);
+        }
+        pow /= 2;
+        if (pow > 0) {
+            base = base.MultiplyLow(base, n);
+        }
+    }
+
+    result.Resize(n);
+    return result;
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::Derivative() const {
+    if (degree_ <= 1) {
+        return Polynomial({0});
+    }
+    std::vector<T> result(degree_ - 1);
+    for (size_t i = 1; i < degree_; ++i) {
+        result[i - 1] = coefficients_[i] * T(i);
+    }
+    return Polynomial(result);
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::Integral() const {
+    std::vector<T> result(degree_ + 1);
+    for (size_t i = 0; i < degree_; ++i) {
+        result[i + 1] = coefficients_[i] / T(i + 1);
+    }
+    return Polynomial(result);
+}
+
+template <typename T>
+std::vector<T> Polynomial<T>::Evaluate(const std::vector<T>& points) const {
+    if (points.empty()) {
+        return {};
+    }
+    INSTRUMENT_SCOPE("Polynomial::Evaluate", T, points.size());
+    SubproductTree<T> tree(points);
+    if (tree.IsStable()) {
+        size_t chunk = points.size();
+        if (degree_ <= 2 * chunk) {
+            return tree.Evaluate(*this);
+        }
+
+        //остаток от деления на корень дерева устойчив, только если степень многочлена
+        //не намного больше числа точек, поэтому длинный многочлен режется на куски
+        //по chunk коэффициентов: p(x) = sum_c P_c(x) * (x^chunk)^c. Каждый кусок
+        //считается деревом, а куски собираются схемой Горнера по y = x^chunk,
+        //всего O(n log^2 k) вместо O(n * k)
+        std::vector<T> shifts(points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            T power = 1, base = points[i];
+            for (size_t exponent = chunk; exponent > 0; exponent /= 2) {
+                if (exponent % 2 == 1) {
+                    power *= base;
+                }
+                base *= base;
+            }
+            shifts[i] = power;
+        }
+
+        std::vector<T> result(points.size());
+        for (size_t end = degree_; end > 0;) {
+            size_t begin = (end - 1) / chunk * chunk;
+            std::vector<T> values = tree.Evaluate(Polynomial(std::vector<T>(
+                coefficients_.begin() + begin, coefficients_.begin() + end)));
+            for (size_t i = 0; i < points.size(); ++i) {
+                result[i] = result[i] * shifts[i] + values[i];
+            }
+            end = begin;
+        }
+        return result;
+    }
+
+    std::vector<T> result(points.size());
+    GetDefaultThreadPool().ParallelFor(0, points.size(), [this, &points, &result](size_t i) {
+        result[i] = EvaluateHorner(coefficients_, points[i]);
+    });
+    return result;
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::Interpolate(const std::vector<T>& points,
+                                         const std::vector<T>& values) {
+    if (points.size() != values.size()) {
+        std::ostringstream os;
+        os << "Exception thrown in Polynomial::Interpolate, sizes of points and values differ: "
+           << points.size() << " != " << values.size() << "\n";
+        throw std::runtime_error(os.str());
+    }
+    if (points.empty()) {
+        return Polynomial({0});
+    }
+
+    INSTRUMENT_SCOPE("Polynomial::Interpolate", T, points.size());
+    using Real = typename T::value_type;
+    SubproductTree<T> tree(points);
+    Polynomial result({0});
+    std::vector<T> residuals;
+    if (tree.IsStable()) {
+        //формула Лагранжа: f(x) = sum_i v_i / M'(x_i) * M(x) / (x - x_i)
+        std::vector<T> weights = tree.Evaluate(tree.GetRoot().Derivative());
+        for (size_t i = 0; i < weights.size(); ++i) {
+            weights[i] = values[i] / weights[i];
+        }
+        result = tree.LinearCombination(weights);
+        result.Resize(points.size());
+        residuals = tree.Evaluate(result);
+    } else {
+        result = Polynomial(InterpolateNewton(points, values));
+        residuals.resize(points.size());
+        GetDefaultThreadPool().ParallelFor(0, points.size(), [&points, &result, &residuals](size_t i) {
+            residuals[i] = EvaluateHorner(result.coefficients_, points[i]);
+        });
+    }
+
+    //коэффициенты по значениям в произвольных точках плохо обусловлены
+    //(матрица Вандермонда), поэтому проверяем, что значения восстановились
+    Real scale = 0, residual = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        scale = std::max(scale, std::abs(values[i]));
+        residual = std::max(residual, std::abs(residuals[i] - values[i]));
+    }
+    if (!(residual <= std::sqrt(std::numeric_limits<Real>::epsilon()) * scale)) {
+        std::ostringstream os;
+        os << "Exception thrown in Polynomial::Interpolate, problem is ill-conditioned: "
+           << "residual " << residual << " for values up to " << scale << "\n";
+        throw std::runtime_error(os.str());
+    }
+    return result;
+}
+
+template <typename T>
+void Polynomial<T>::Resize(size_t degree) {
+    coefficients_.resize(degree, T(0));
+    degree_ = degree;
+}
+
 
 template <typename T>
 const Polynomial<T> Polynomial<T>::operator+(const Polynomial& other) const {
@@ -147,6 +791,18 @@ const Polynomial<T> Polynomial<T>::operator^(size_t pow) const {
     return result ^= pow;
 }
 
+template <typename T>
+const Polynomial<T> Polynomial<T>::operator/(const Polynomial<T>& other) const {
+    Polynomial<T> result = *this;
+    return result /= other;
+}
+
+template <typename T>
+const Polynomial<T> Polynomial<T>::operator%(const Polynomial<T>& other) const {
+    Polynomial<T> result = *this;
+    return result %= other;
+}
+
 template <typename T>
 const std::vector<T> Polynomial<T>::GetCoefficients() const {
     return coefficients_;
@@ -174,6 +830,11 @@ std::ostream& operator<<(std::ostream& ostr, const Polynomial<T>& polynomial) {
 
     const std::vector<T>& coeffs = polynomial.coefficients_;
 
+    if (Accuracy::IsEnabled()) {
+        Accuracy::Record("Polynomial::operator<<", polynomial.degree_,
+                         Accuracy::MaxDistanceToInteger(begin(coeffs), end(coeffs)), NAN);
+    }
+
     if (polynomial.degree_ == 0) {
         return ostr;
     }
@@ -240,6 +901,84 @@ std::ostream& operator<<(std::ostream& ostr, const Polynomial<T>& polynomial) {
     return ostr;
 }
 
+template <typename T>
+Polynomial<T> ProductOf(const std::vector<Polynomial<T>>& polynomials) {
+    if (polynomials.empty()) {
+        return Polynomial<T>({1});
+    }
+    INSTRUMENT_SCOPE("ProductOf", T, polynomials.size());
+
+    //строим дерево Хаффмана по степеням: первые polynomials.size() узлов - листья
+    struct Node {
+      size_t degree;
+      size_t left;
+      size_t right;
+      size_t height;
+    };
+    std::vector<Node> nodes;
+    nodes.reserve(2 * polynomials.size() - 1);
+
+    using QueueItem = std::pair<size_t, size_t>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+    for (size_t i = 0; i < polynomials.size(); ++i) {
+        nodes.push_back({polynomials[i].GetDegree(), i, i, 0});
+        queue.push({polynomials[i].GetDegree(), i});
+    }
+
+    size_t max_height = 0;
+    while (queue.size() > 1) {
+        size_t left = queue.top().second;
+        queue.pop();
+        size_t right = queue.top().second;
+        queue.pop();
+
+        size_t degree = nodes[left].degree == 0 || nodes[right].degree == 0
+                        ? 0 : nodes[left].degree + nodes[right].degree - 1;
+        size_t height = std::max(nodes[left].height, nodes[right].height) + 1;
+        max_height = std::max(max_height, height);
+
+        nodes.push_back({degree, left, right, height});
+        queue.push({degree, nodes.size() - 1});
+    }
+
+    //узлы одной высоты зависят только от более низких, вычисляем их параллельно
+    std::vector<std::vector<size_t>> levels(max_height + 1);
+    for (size_t i = polynomials.size(); i < nodes.size(); ++i) {
+        levels[nodes[i].height].push_back(i);
+    }
+
+    std::vector<Polynomial<T>> products(nodes.size(), Polynomial<T>(std::vector<T>()));
+    auto get = [&polynomials, &products](size_t index) -> const Polynomial<T>& {
+        return index < polynomials.size() ? polynomials[index] : products[index];
+    };
+
+    for (size_t height = 1; height <= max_height; ++height) {
+        const std::vector<size_t>& level = levels[height];
+        GetDefaultThreadPool().ParallelFor(
+            0, level.size(), [&level, &nodes, &polynomials, &products, &get](size_t j) {
+                const Node& node = nodes[level[j]];
+                const Polynomial<T>& left = get(node.left);
+                const Polynomial<T>& right = get(node.right);
+
+                if (std::min(left.GetDegree(), right.GetDegree()) <= kNaiveMultiplicationSize) {
+                    products[level[j]] = MultiplyNaive(left, right);
+                } else {
+                    products[level[j]] = left * right;
+                }
+
+                //промежуточные произведения больше не нужны
+                if (node.left >= polynomials.size()) {
+                    products[node.left] = Polynomial<T>(std::vector<T>());
+                }
+                if (node.right >= polynomials.size()) {
+                    products[node.right] = Polynomial<T>(std::vector<T>());
+                }
+            });
+    }
+
+    return nodes.size() == 1 ? polynomials[0] : products.back();
+}
+
 template class Polynomial<std::complex<float>>;
 template class Polynomial<std::complex<double>>;
 template class Polynomial<std::complex<long double>>;
@@ -256,4 +995,11 @@ operator<<(std::ostream& ostr, const Polynomial<std::complex<float>>& polynomial
 template std::ostream&
 operator<<(std::ostream& ostr, const Polynomial<std::complex<double>>& polynomial);
 template std::ostream&
-operator<<(std::ostream& ostr, const Polynomial<std::complex<long double>>& polynomial);
\ No newline at end of file
+operator<<(std::ostream& ostr, const Polynomial<std::complex<long double>>& polynomial);
+
+template Polynomial<std::complex<float>>
+ProductOf(const std::vector<Polynomial<std::complex<float>>>& polynomials);
+template Polynomial<std::complex<double>>
+ProductOf(const std::vector<Polynomial<std::complex<double>>>& polynomials);
+template Polynomial<std::complex<long double>>
+ProductOf(const std::vector<Polynomial<std::complex<long double>>>& polynomials);
\ No newline at end of file
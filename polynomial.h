@@ -9,6 +9,10 @@
 #include <complex>
 #include <initializer_list>
 
+namespace OutOfCore {
+template <typename T>
+class MappedArray;
+} // namespace OutOfCore
 
 // Операции над многочленами с помощью ффт
 template <typename T>
@@ -47,6 +51,70 @@ class Polynomial {
   // Возведение в степень pow с помощью комбинации FFT и индийского возведения в степень
   Polynomial& operator^=(size_t pow);
 
+  // Деление с остатком за O(n log n): частное находится через обратный ряд
+  // к развернутому делителю. Если старшие коэффициенты a - q * b не сократились
+  // до sqrt(eps) * max |a|, частное пересчитывается делением в столбик за O(n * m).
+  // Бросает std::runtime_error, если старший коэффициент делителя не больше
+  // eps * max |b|
+  Polynomial& operator/=(const Polynomial& other);
+
+  Polynomial& operator%=(const Polynomial& other);
+
+  // Обратный степенной ряд по модулю x^n, вычисляется итерациями Ньютона
+  // g <- g * (2 - f * g), на каждой из которых точность удваивается,
+  // бросает std::runtime_error, если свободный член нулевой
+  const Polynomial Inverse(size_t n) const;
+
+  // Первые n коэффициентов произведения, лишние коэффициенты множителей не участвуют
+  const Polynomial MultiplyLow(const Polynomial& other, size_t n) const;
+
+  // Точный режим умножения для целых коэффициентов, помещающихся в int64_t:
+  // произведение считается IntegerMultiplication::MultiplyExact, а не FFT в точности T.
+  // Коэффициенты результата точны, пока помещаются в мантиссу T, иначе округляются
+  // один раз к ближайшему значению T. Бросает std::runtime_error, если у множителей
+  // есть нецелые коэффициенты, ненулевые мнимые части или значения вне int64_t,
+  // а также если коэффициент произведения не помещается в __int128
+  const Polynomial MultiplyExact(const Polynomial& other) const;
+
+  // Умножение многочленов, коэффициенты которых не помещаются в память: множители
+  // и результат лежат в отображенных файлах (out_of_core.h), произведение пишется
+  // в файл result_path, рабочие файлы создаются в scratch_directory.
+  // Обертка над OutOfCore::MultiplyPolynomials
+  static OutOfCore::MappedArray<T> MultiplyMapped(const OutOfCore::MappedArray<T>& first,
+                                                  const OutOfCore::MappedArray<T>& second,
+                                                  const std::string& result_path,
+                                                  const std::string& scratch_directory);
+
+  // Операции над степенными рядами по модулю x^n, итерации Ньютона поверх MultiplyLow.
+  // Логарифм определен для ряда со свободным членом 1, экспонента - с нулевым,
+  // корень - с ненулевым, иначе бросается std::runtime_error
+  const Polynomial Log(size_t n) const;
+
+  const Polynomial Exp(size_t n) const;
+
+  const Polynomial Sqrt(size_t n) const;
+
+  // Степень pow по модулю x^n, в отличие от operator^= не считает старшие коэффициенты
+  const Polynomial PowMod(size_t pow, size_t n) const;
+
+  // Значения многочлена в точках points: остатки от деления на (x - x_i)
+  // спускаются по дереву подпроизведений, O(n log^2 k) вместо O(n * k) у схемы Горнера.
+  // Многочлен степени больше 2k режется на куски по k коэффициентов, которые
+  // считаются деревом и собираются схемой Горнера по x^k.
+  // Деление точно, только пока коэффициенты узлов дерева порядка 1. Так бывает для
+  // корней из 1 в бит-реверсном порядке (при любом k) и для точек в круге |x| <= 1/4,
+  // но не для действительных точек на [-1, 1]: там коэффициенты узлов растут
+  // экспоненциально уже с сотни точек, и значения считаются схемой Горнера
+  std::vector<T> Evaluate(const std::vector<T>& points) const;
+
+  // Многочлен с points.size() коэффициентами, принимающий в попарно различных
+  // точках points значения values, строится по тому же дереву, а если оно неточно -
+  // разделенными разностями Ньютона за O(n^2). Коэффициенты по значениям
+  // в произвольных точках плохо обусловлены, поэтому если полученный многочлен
+  // отличается в точках от values больше чем на sqrt(eps) * max |values|,
+  // бросается std::runtime_error
+  static Polynomial Interpolate(const std::vector<T>& points, const std::vector<T>& values);
+
   template <typename U>
   friend std::ostream& operator<<(std::ostream& ostr, const Polynomial<U>& polynomial);
 
@@ -59,6 +127,10 @@ class Polynomial {
 
   const Polynomial operator^(size_t pow) const;
 
+  const Polynomial operator/(const Polynomial& other) const;
+
+  const Polynomial operator%(const Polynomial& other) const;
+
   // И еще один, унарный минус
   template <typename U>
   friend const Polynomial<U> operator- (const Polynomial<U>& other);
@@ -67,10 +139,26 @@ class Polynomial {
   const std::vector<T> GetCoefficients() const;
 
  private:
+  // Обрезает или дополняет нулями до degree коэффициентов
+  void Resize(size_t degree);
+
+  // Частное от деления на other, остаток записывается в remainder, если он задан
+  Polynomial Divide(const Polynomial& other, Polynomial* remainder) const;
+
+  Polynomial Derivative() const;
+
+  Polynomial Integral() const;
+
   std::vector<T> coefficients_;
   size_t degree_;
 };
 
+// Произведение всех многочленов: множители объединяются по дереву Хаффмана
+// (всегда перемножаются два многочлена наименьшей степени), короткие произведения
+// считаются в столбик, длинные - через FFT, независимые поддеревья - параллельно
+template <typename T>
+Polynomial<T> ProductOf(const std::vector<Polynomial<T>>& polynomials);
+
 
 //Тесты для Polynomial
 namespace PolynomialTests {
@@ -79,4 +167,9 @@ void AddAndSubstractOperators();
 void OutputStream();
 void Multiply();
 void Power();
+void LazyExpressions();
+void Division();
+void EvaluateAndInterpolate();
+void Product();
+void PowerSeries();
 } // namespace PolynomialTests
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <complex>
+#include <cstdlib>
+#include <vector>
+
+#include "fft.h"
+#include "polynomial.h"
+
+// Ленивые выражения над многочленами: Lazy(a) * b + Lazy(c) * d - e не вычисляется
+// по одной операции, а собирается в дерево, которое вычисляется за один проход -
+// все листья преобразуются к общей длине, суммы, разности и произведения
+// считаются поточечно в частотной области, обратное преобразование одно на все выражение
+//
+// Листья хранят ссылки на многочлены, поэтому выражение должно быть вычислено,
+// пока живы многочлены, из которых оно построено; временные многочлены
+// в выражение не принимаются, поэтому каждое произведение начинается с Lazy:
+// в Lazy(a) * b + c * d произведение c * d уже вычислено и временно
+namespace PolynomialExpressions {
+template <typename Derived, typename T>
+class Expression {
+ public:
+  const Derived& Self() const {
+      return static_cast<const Derived&>(*this);
+  }
+
+  Polynomial<T> Evaluate() const {
+      size_t degree = Self().GetDegree();
+
+      size_t new_deg = 1;
+      while (new_deg < degree) {
+          new_deg *= 2;
+      }
+
+      std::vector<T> coefficients = FFT::FastInverseFourierTransform(Self().Values(new_deg));
+      coefficients.resize(degree);
+      return Polynomial<T>(coefficients);
+  }
+
+  operator Polynomial<T>() const {
+      return Evaluate();
+  }
+};
+
+template <typename T>
+class Leaf : public Expression<Leaf<T>, T> {
+ public:
+  explicit Leaf(const Polynomial<T>& polynomial)
+      : polynomial_(&polynomial) {
+  }
+
+  size_t GetDegree() const {
+      return polynomial_->GetDegree();
+  }
+
+  // Значения многочлена в корнях степени length из 1
+  std::vector<T> Values(size_t length) const {
+      return FFT::FastFourierTransform(
+          FFT::AddPadding<T>(polynomial_->GetCoefficients(), length)
+      );
+  }
+
+ private:
+  const Polynomial<T>* polynomial_;
+};
+
+template <typename L, typename R, typename T>
+class Sum : public Expression<Sum<L, R, T>, T> {
+ public:
+  Sum(const L& left, const R& right)
+      : left_(left), right_(right) {
+  }
+
+  size_t GetDegree() const {
+      return std::max(left_.GetDegree(), right_.GetDegree());
+  }
+
+  std::vector<T> Values(size_t length) const {
+      std::vector<T> result = left_.Values(length);
+      std::vector<T> right_values = right_.Values(length);
+      for (size_t i = 0; i < length; ++i) {
+          result[i] += right_values[i];
+      }
+      return result;
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+template <typename L, typename R, typename T>
+class Difference : public Expression<Difference<L, R, T>, T> {
+ public:
+  Difference(const L& left, const R& right)
+      : left_(left), right_(right) {
+  }
+
+  size_t GetDegree() const {
+      return std::max(left_.GetDegree(), right_.GetDegree());
+  }
+
+  std::vector<T> Values(size_t length) const {
+      std::vector<T> result = left_.Values(length);
+      std::vector<T> right_values = right_.Values(length);
+      for (size_t i = 0; i < length; ++i) {
+          result[i] -= right_values[i];
+      }
+      return result;
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+template <typename L, typename R, typename T>
+class Product : public Expression<Product<L, R, T>, T> {
+ public:
+  Product(const L& left, const R& right)
+      : left_(left), right_(right) {
+  }
+
+  // у произведения с пустым множителем коэффициентов нет, как у MultiplyNaive
+  size_t GetDegree() const {
+      size_t left = left_.GetDegree(), right = right_.GetDegree();
+      return left == 0 || right == 0 ? 0 : left + right - 1;
+  }
+
+  // длина преобразования выбирается по степени всего выражения,
+  // поэтому циклическая свертка совпадает с обычным произведением
+  std::vector<T> Values(size_t length) const {
+      std::vector<T> result = left_.Values(length);
+      std::vector<T> right_values = right_.Values(length);
+      for (size_t i = 0; i < length; ++i) {
+          result[i] *= right_values[i];
+      }
+      return result;
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+template <typename E, typename T>
+class Negation : public Expression<Negation<E, T>, T> {
+ public:
+  explicit Negation(const E& expression)
+      : expression_(expression) {
+  }
+
+  size_t GetDegree() const {
+      return expression_.GetDegree();
+  }
+
+  std::vector<T> Values(size_t length) const {
+      std::vector<T> result = expression_.Values(length);
+      for (auto& value : result) {
+          value = -value;
+      }
+      return result;
+  }
+
+ private:
+  E expression_;
+};
+
+// Начало ленивого выражения: PolynomialExpressions::Lazy(a) * b + c
+template <typename T>
+Leaf<T> Lazy(const Polynomial<T>& polynomial) {
+    return Leaf<T>(polynomial);
+}
+
+// от временного многочлена остался бы висячий указатель, const && ловит и
+// результаты операторов Polynomial, которые возвращают const Polynomial
+template <typename T>
+Leaf<T> Lazy(const Polynomial<T>&& polynomial) = delete;
+
+// смешанные операторы с временным многочленом удалены, как и Lazy(Polynomial&&)
+template <typename L, typename R, typename T>
+Sum<L, R, T> operator+(const Expression<L, T>& left, const Expression<R, T>& right) {
+    return {left.Self(), right.Self()};
+}
+
+template <typename L, typename T>
+Sum<L, Leaf<T>, T> operator+(const Expression<L, T>& left, const Polynomial<T>& right) {
+    return {left.Self(), Leaf<T>(right)};
+}
+
+template <typename R, typename T>
+Sum<Leaf<T>, R, T> operator+(const Polynomial<T>& left, const Expression<R, T>& right) {
+    return {Leaf<T>(left), right.Self()};
+}
+
+template <typename L, typename T>
+void operator+(const Expression<L, T>& left, const Polynomial<T>&& right) = delete;
+
+template <typename R, typename T>
+void operator+(const Polynomial<T>&& left, const Expression<R, T>& right) = delete;
+
+template <typename L, typename R, typename T>
+Difference<L, R, T> operator-(const Expression<L, T>& left, const Expression<R, T>& right) {
+    return {left.Self(), right.Self()};
+}
+
+template <typename L, typename T>
+Difference<L, Leaf<T>, T> operator-(const Expression<L, T>& left, const Polynomial<T>& right) {
+    return {left.Self(), Leaf<T>(right)};
+}
+
+template <typename R, typename T>
+Difference<Leaf<T>, R, T> operator-(const Polynomial<T>& left, const Expression<R, T>& right) {
+    return {Leaf<T>(left), right.Self()};
+}
+
+template <typename L, typename T>
+void operator-(const Expression<L, T>& left, const Polynomial<T>&& right) = delete;
+
+template <typename R, typename T>
+void operator-(const Polynomial<T>&& left, const Expression<R, T>& right) = delete;
+
+template <typename L, typename R, typename T>
+Product<L, R, T> operator*(const Expression<L, T>& left, const Expression<R, T>& right) {
+    return {left.Self(), right.Self()};
+}
+
+template <typename L, typename T>
+Product<L, Leaf<T>, T> operator*(const Expression<L, T>& left, const Polynomial<T>& right) {
+    return {left.Self(), Leaf<T>(right)};
+}
+
+template <typename R, typename T>
+Product<Leaf<T>, R, T> operator*(const Polynomial<T>& left, const Expression<R, T>& right) {
+    return {Leaf<T>(left), right.Self()};
+}
+
+template <typename L, typename T>
+void operator*(const Expression<L, T>& left, const Polynomial<T>&& right) = delete;
+
+template <typename R, typename T>
+void operator*(const Polynomial<T>&& left, const Expression<R, T>& right) = delete;
+
+template <typename E, typename T>
+Negation<E, T> operator-(const Expression<E, T>& expression) {
+    return Negation<E, T>(expression.Self());
+}
+} // namespace PolynomialExpressions
@@ -1,8 +1,46 @@
 #include "fft.h"
 #include "test_runner.h"
 #include "polynomial.h"
+#include "polynomial_expression.h"
+
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace PolynomialTests {
+namespace {
+//Есть ли подходящий и не удаленный operator* для аргументов типов L и R
+template <typename L, typename R, typename = void>
+struct IsMultipliable : std::false_type {};
+
+template <typename L, typename R>
+struct IsMultipliable<L, R, std::void_t<decltype(std::declval<L>() * std::declval<R>())>>
+    : std::true_type {};
+
+template <typename L, typename R, typename = void>
+struct IsAddable : std::false_type {};
+
+template <typename L, typename R>
+struct IsAddable<L, R, std::void_t<decltype(std::declval<L>() + std::declval<R>())>>
+    : std::true_type {};
+
+template <typename L, typename R, typename = void>
+struct IsSubtractable : std::false_type {};
+
+template <typename L, typename R>
+struct IsSubtractable<L, R, std::void_t<decltype(std::declval<L>() - std::declval<R>())>>
+    : std::true_type {};
+
+//Можно ли начать ленивое выражение с многочлена типа P
+template <typename P, typename = void>
+struct IsLazyLeaf : std::false_type {};
+
+template <typename P>
+struct IsLazyLeaf<P, std::void_t<decltype(PolynomialExpressions::Lazy(std::declval<P>()))>>
+    : std::true_type {};
+}
+
 void CompareOperator() {
     using std::complex;
     using std::vector;
@@ -90,4 +128,386 @@ void Power() {
     p6 ^= 2;
     ASSERT_EQUAL(p5, p6);
 }
+
+void LazyExpressions() {
+    using std::complex;
+    using PolynomialExpressions::Lazy;
+
+    Polynomial<complex<long double>>
+        a({1, 2, 3}), b({3, 2, 1}), c({7, 2, 13, 6}), d({3, 1, 0, 0, 5, 8, 9}), e({1, 1});
+
+    Polynomial<complex<long double>> p1 = Lazy(a) * b + Lazy(c) * d - e;
+    ASSERT_EQUAL(p1, a * b + c * d - e);
+    ASSERT_EQUAL(p1.GetDegree(), (c * d).GetDegree());
+
+    Polynomial<complex<long double>> p2 = (Lazy(a) + b) * (Lazy(c) - d) * e;
+    ASSERT_EQUAL(p2, (a + b) * (c - d) * e);
+
+    ASSERT_EQUAL((-Lazy(a) * a).Evaluate(), -(a * a));
+    ASSERT_EQUAL((e - Lazy(a)).Evaluate(), e - a);
+
+    //произведение с пустым многочленом пусто, а не SIZE_MAX коэффициентов
+    Polynomial<complex<long double>> empty(std::vector<complex<long double>>{});
+    ASSERT_EQUAL((Lazy(a) * empty).GetDegree(), 0u);
+    ASSERT_EQUAL((Lazy(empty) * empty).Evaluate().GetDegree(), 0u);
+    ASSERT_EQUAL((Lazy(a) * empty + b).Evaluate(), b);
+
+    //временный многочлен в выражении не компилируется: лист держал бы висячий указатель
+    using Leaf = PolynomialExpressions::Leaf<complex<long double>>;
+    using Temporary = Polynomial<complex<long double>>;
+    static_assert(IsMultipliable<Leaf, const Temporary&>::value);
+    static_assert(!IsMultipliable<Leaf, Temporary>::value);
+    static_assert(!IsMultipliable<Leaf, const Temporary>::value);
+    static_assert(!IsMultipliable<const Temporary, Leaf>::value);
+    static_assert(IsAddable<Leaf, const Temporary&>::value);
+    static_assert(!IsAddable<Leaf, const Temporary>::value);
+    static_assert(!IsAddable<const Temporary, Leaf>::value);
+    static_assert(IsSubtractable<Leaf, const Temporary&>::value);
+    static_assert(!IsSubtractable<Leaf, const Temporary>::value);
+    static_assert(!IsSubtractable<const Temporary, Leaf>::value);
+    static_assert(IsLazyLeaf<const Temporary&>::value);
+    static_assert(!IsLazyLeaf<Temporary>::value);
+    static_assert(!IsLazyLeaf<const Temporary>::value);
+
+    //в Lazy(a) * b + c * d произведение c * d вычислено и временно
+    using LazyProduct = decltype(Lazy(std::declval<const Temporary&>()) *
+                                 std::declval<const Temporary&>());
+    static_assert(IsAddable<LazyProduct, LazyProduct>::value);
+    static_assert(!IsAddable<LazyProduct, decltype(c * d)>::value);
+}
+
+void Division() {
+    using std::complex;
+
+    Polynomial<complex<long double>>
+        p1({7, 2, 13, 6}),
+        p2({3, 1, 0, 0, 5, 8, 9}),
+        p3({21, 13, 41, 31, 41, 66, 144, 152, 165, 54}),
+        p4({1, 2, 3});
+
+    ASSERT_EQUAL(p3 / p1, p2);
+    ASSERT_EQUAL(p3 / p2, p1);
+    ASSERT_EQUAL((p3 % p1).GetDegree(), 3u);
+    ASSERT_EQUAL(p3 % p1, Polynomial<complex<long double>>({0, 0, 0}));
+
+    //p3 + p4 = p1 * p2 + p4, а p4 короче p1
+    Polynomial<complex<long double>> p5 = p3 + p4;
+    ASSERT_EQUAL(p5 / p1, p2);
+    ASSERT_EQUAL(p5 % p1, p4);
+    ASSERT_EQUAL(p4 / p1, Polynomial<complex<long double>>({0}));
+    ASSERT_EQUAL(p4 % p1, p4);
+
+    //делитель с нулевым старшим коэффициентом отвергается и / и %,
+    //даже если делимое короче делителя
+    for (const auto& dividend : {p3, p4}) {
+        for (bool remainder : {false, true}) {
+            bool thrown = false;
+            try {
+                remainder ? dividend % Polynomial<complex<long double>>({1, 2, 3, 4, 0})
+                          : dividend / Polynomial<complex<long double>>({1, 2, 3, 4, 0});
+            } catch (std::runtime_error&) {
+                thrown = true;
+            }
+            ASSERT(thrown);
+        }
+    }
+
+    p5 /= p2;
+    ASSERT_EQUAL(p5, p1);
+
+    //1 / (1 - x) = 1 + x + x^2 + ...
+    Polynomial<complex<long double>> p6({1, -1});
+    ASSERT_EQUAL(p6.Inverse(5), Polynomial<complex<long double>>({1, 1, 1, 1, 1}));
+
+    Polynomial<complex<long double>> p7 = p1.Inverse(20);
+    ASSERT_EQUAL(p7.GetDegree(), 20u);
+    Polynomial<complex<long double>> p8 = p1 * p7;
+    std::vector<complex<long double>> low = p8.GetCoefficients();
+    low.resize(20);
+    std::vector<complex<long double>> unit(20);
+    unit[0] = 1;
+    ASSERT_VECTOR(low, unit, 1.0e-6);
+
+    //длинные делители с маленькими целыми коэффициентами: обратный ряд к развернутому
+    //делителю теряет точность на сокращениях, и частное досчитывается в столбик
+    std::mt19937_64 generator(42);
+    auto random_polynomial = [&generator](size_t size, int bound) {
+        std::uniform_int_distribution<int> distribution(-bound, bound);
+        std::vector<complex<long double>> coefficients(size);
+        for (auto& coefficient : coefficients) {
+            coefficient = distribution(generator);
+        }
+        if (coefficients.back() == complex<long double>(0)) {
+            coefficients.back() = 1;
+        }
+        return Polynomial<complex<long double>>(coefficients);
+    };
+    using Sizes = std::tuple<size_t, size_t, int>;
+    for (auto [divisor_size, quotient_size, bound] : {Sizes{50, 1000, 5}, Sizes{500, 1001, 1},
+                                                      Sizes{1000, 3000, 1}}) {
+        Polynomial<complex<long double>> divisor = random_polynomial(divisor_size, bound);
+        Polynomial<complex<long double>> quotient = random_polynomial(quotient_size, 5);
+        Polynomial<complex<long double>> remainder = random_polynomial(divisor_size - 1, 5);
+        std::vector<complex<long double>> coefficients =
+            (divisor * quotient + remainder).GetCoefficients();
+        for (auto& coefficient : coefficients) {
+            coefficient = std::round(std::real(coefficient));
+        }
+        Polynomial<complex<long double>> dividend(coefficients);
+        ASSERT_EQUAL(dividend / divisor, quotient);
+        ASSERT_EQUAL(dividend % divisor, remainder);
+        ASSERT_EQUAL((dividend / divisor) * divisor + dividend % divisor, dividend);
+    }
+
+    bool thrown = false;
+    try {
+        Polynomial<complex<long double>>({0, 1}).Inverse(4);
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+
+    //старший коэффициент на уровне ошибки округления - все равно что ноль
+    thrown = false;
+    try {
+        p1 / Polynomial<complex<long double>>({1, 1, 1.0e-30L});
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+
+void EvaluateAndInterpolate() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-6;
+
+    Polynomial<complex<long double>> p1({1, 2, 3});
+    vector<complex<long double>> v1 = {6, 17, 34, 1, 2};
+    ASSERT_VECTOR(p1.Evaluate({1, 2, 3, 0, -1}), v1, error);
+    ASSERT_EQUAL(Polynomial<complex<long double>>::Interpolate({1, 2, 3}, {6, 17, 34}), p1);
+
+    //точек больше, чем обрабатывается схемой Горнера в одном узле
+    vector<complex<long double>> points(300), expected(300);
+    Polynomial<complex<long double>> p2({7, 2, 13, 6});
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = complex<long double>(i % 2 ? -(i / 100.0L) : i / 100.0L, 0);
+        complex<long double> x = points[i];
+        expected[i] = 7.0L + x * (2.0L + x * (13.0L + x * 6.0L));
+    }
+    ASSERT_VECTOR(p2.Evaluate(points), expected, error);
+
+    //корни из 1 в бит-реверсном порядке: тогда каждый узел дерева имеет вид
+    //x^k - c и деление на него устойчиво
+    vector<complex<long double>> roots(64);
+    for (size_t i = 0; i < roots.size(); ++i) {
+        size_t reversed = 0;
+        for (size_t bit = 1, rbit = roots.size() / 2; bit < roots.size(); bit *= 2, rbit /= 2) {
+            if (i & bit) {
+                reversed |= rbit;
+            }
+        }
+        roots[i] = std::polar(1.0L, 2 * acosl(-1) * reversed / roots.size());
+    }
+    Polynomial<complex<long double>> p3({3, 1, 0, 0, 5, 8, 9, 2, 1, 1, 4});
+    vector<complex<long double>> p3_coefficients = p3.GetCoefficients();
+    p3_coefficients.resize(roots.size());
+    ASSERT_VECTOR(
+        Polynomial<complex<long double>>::Interpolate(roots, p3.Evaluate(roots)).GetCoefficients(),
+        p3_coefficients, error
+    );
+
+    //многочлен длиннее 2 * 64 коэффициентов считается кусками по 64 через то же дерево
+    vector<complex<long double>> long_coefficients(1000);
+    for (size_t i = 0; i < long_coefficients.size(); ++i) {
+        long_coefficients[i] = complex<long double>(long(i * 7 % 11) - 5, long(i % 3) - 1);
+    }
+    vector<complex<long double>> long_expected(roots.size());
+    for (size_t i = 0; i < roots.size(); ++i) {
+        for (size_t k = long_coefficients.size(); k > 0; --k) {
+            long_expected[i] = long_expected[i] * roots[i] + long_coefficients[k - 1];
+        }
+    }
+    ASSERT_VECTOR(Polynomial<complex<long double>>(long_coefficients).Evaluate(roots),
+                  long_expected, error);
+
+    //произвольные точки: погрешность относительно sum |c_k| |x|^k как у схемы Горнера,
+    //и на отрезке [-1, 1], где дерево неустойчиво, и на [-1/4, 1/4], где устойчиво
+    //и многочлен из 1000 коэффициентов считается кусками по 300
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> distribution(-1, 1);
+    vector<complex<double>> coefficients(1000), wide(1000), narrow(300);
+    for (auto& coefficient : coefficients) {
+        coefficient = distribution(generator);
+    }
+    for (auto& point : wide) {
+        point = distribution(generator);
+    }
+    for (auto& point : narrow) {
+        point = distribution(generator) / 4;
+    }
+    Polynomial<complex<double>> p4(coefficients);
+    for (const auto& points : {wide, narrow}) {
+        vector<complex<double>> values = p4.Evaluate(points);
+        double max_error = 0;
+        for (size_t i = 0; i < points.size(); ++i) {
+            complex<long double> value = 0, x = points[i];
+            long double scale = 0;
+            for (size_t k = coefficients.size(); k > 0; --k) {
+                value = value * x + complex<long double>(coefficients[k - 1]);
+                scale = scale * std::abs(x) + std::abs(coefficients[k - 1]);
+            }
+            max_error = std::max(max_error, double(std::abs(value - complex<long double>(values[i])) / scale));
+        }
+        ASSERT(max_error < 1e-13);
+    }
+
+    //целые точки 0..19: значения до 10^25, в точках многочлен восстанавливается
+    //с относительной точностью, а коэффициенты при малых степенях - уже нет
+    vector<complex<long double>> integers(20), p5_coefficients(20);
+    for (size_t i = 0; i < integers.size(); ++i) {
+        integers[i] = i;
+        p5_coefficients[i] = long(i * 7 % 11) - 5;
+    }
+    Polynomial<complex<long double>> p5(p5_coefficients);
+    vector<complex<long double>> p5_values = p5.Evaluate(integers);
+    vector<complex<long double>> restored =
+        Polynomial<complex<long double>>::Interpolate(integers, p5_values).Evaluate(integers);
+    for (size_t i = 0; i < integers.size(); ++i) {
+        ASSERT(std::abs(restored[i] - p5_values[i]) <= 1e-12L * std::abs(p5_values.back()));
+    }
+
+    //на 0..11 значения меньше 10^13 и коэффициенты восстанавливаются точно
+    integers.resize(12);
+    p5_coefficients.resize(12);
+    Polynomial<complex<long double>> p6(p5_coefficients);
+    ASSERT_EQUAL(Polynomial<complex<long double>>::Interpolate(integers, p6.Evaluate(integers)), p6);
+
+    //коэффициенты по значениям в 200 произвольных точках не восстановить
+    wide.resize(200);
+    vector<complex<double>> wide_values(begin(coefficients), begin(coefficients) + 200);
+    bool thrown = false;
+    try {
+        Polynomial<complex<double>>::Interpolate(wide, wide_values);
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+
+void Product() {
+    using std::complex;
+    using std::vector;
+
+    Polynomial<complex<long double>>
+        p1({7, 2, 13, 6}),
+        p2({3, 1, 0, 0, 5, 8, 9}),
+        p3({1, 2, 3});
+
+    ASSERT_EQUAL(ProductOf<complex<long double>>({}), Polynomial<complex<long double>>({1}));
+    ASSERT_EQUAL(ProductOf<complex<long double>>({p1}), p1);
+    ASSERT_EQUAL(ProductOf<complex<long double>>({p1, p2, p3}), p1 * p2 * p3);
+
+    //пустой множитель делает пустым все произведение
+    Polynomial<complex<long double>> empty(vector<complex<long double>>{});
+    ASSERT_EQUAL(ProductOf<complex<long double>>({p1, empty, p2}).GetDegree(), 0u);
+    ASSERT_EQUAL(ProductOf<complex<long double>>({empty, empty}).GetDegree(), 0u);
+
+    //множители разной длины: нижние уровни дерева умножаются в столбик,
+    //верхние - через FFT
+    vector<Polynomial<complex<long double>>> factors;
+    Polynomial<complex<long double>> expected({1});
+    for (size_t i = 0; i < 30; ++i) {
+        factors.push_back(Polynomial<complex<long double>>({1, 1}));
+        expected *= factors.back();
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        factors.push_back(Polynomial<complex<long double>>(vector<complex<long double>>(40, 1)));
+        expected *= factors.back();
+    }
+    Polynomial<complex<long double>> product = ProductOf(factors);
+    ASSERT_EQUAL(product.GetDegree(), expected.GetDegree());
+    ASSERT_EQUAL(product, expected);
+}
+
+void PowerSeries() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-9;
+
+    Polynomial<complex<long double>> p1({7, 2, 13, 6}), p2({3, 1, 0, 0, 5, 8, 9});
+    vector<complex<long double>> low = (p1 * p2).GetCoefficients();
+    low.resize(5);
+    ASSERT_VECTOR(p1.MultiplyLow(p2, 5).GetCoefficients(), low, error);
+
+    //exp(x) = sum x^k / k!
+    vector<complex<long double>> exp_coefficients(50);
+    long double factorial = 1;
+    for (size_t k = 0; k < exp_coefficients.size(); ++k) {
+        exp_coefficients[k] = 1 / factorial;
+        factorial *= k + 1;
+    }
+    Polynomial<complex<long double>> x({0, 1});
+    ASSERT_VECTOR(x.Exp(50).GetCoefficients(), exp_coefficients, error);
+
+    //log(1 + x) = sum (-1)^(k + 1) x^k / k
+    vector<complex<long double>> log_coefficients(40);
+    for (size_t k = 1; k < log_coefficients.size(); ++k) {
+        log_coefficients[k] = (k % 2 ? 1.0L : -1.0L) / k;
+    }
+    Polynomial<complex<long double>> p3({1, 1});
+    ASSERT_VECTOR(p3.Log(40).GetCoefficients(), log_coefficients, error);
+
+    //exp(log f) = f
+    Polynomial<complex<long double>> p4({1, 3, -2, 5, 1});
+    vector<complex<long double>> p4_coefficients = p4.GetCoefficients();
+    p4_coefficients.resize(70);
+    ASSERT_VECTOR(p4.Log(70).Exp(70).GetCoefficients(), p4_coefficients, 1.0e-6);
+
+    //длинные ряды: произведения уже идут через ффт, в том числе в double
+    for (size_t n : {129, 256, 1000, 4096}) {
+        vector<complex<long double>> long_exp(n);
+        long double term = 1;
+        for (size_t k = 0; k < n; ++k) {
+            long_exp[k] = term;
+            term /= k + 1;
+        }
+        ASSERT_VECTOR(x.Exp(n).GetCoefficients(), long_exp, error);
+
+        vector<complex<double>> double_exp(begin(long_exp), end(long_exp));
+        Polynomial<complex<double>> double_x({0, 1});
+        ASSERT_VECTOR(double_x.Exp(n).GetCoefficients(), double_exp, 1.0e-9);
+
+        p4_coefficients = p4.GetCoefficients();
+        p4_coefficients.resize(n);
+        ASSERT_VECTOR(p4.Log(n).Exp(n).GetCoefficients(), p4_coefficients, 1.0e-6);
+    }
+
+    //sqrt((1 + x)^2) = 1 + x, sqrt(4 + ...) начинается с 2
+    Polynomial<complex<long double>> p5 = p3 * p3;
+    ASSERT_VECTOR(p5.Sqrt(8).GetCoefficients(),
+                  vector<complex<long double>>({1, 1, 0, 0, 0, 0, 0, 0}), error);
+    Polynomial<complex<long double>> p6 = p1 * p1;
+    vector<complex<long double>> p1_coefficients = p1.GetCoefficients();
+    p1_coefficients.resize(6);
+    ASSERT_VECTOR(p6.Sqrt(6).GetCoefficients(), p1_coefficients, 1.0e-6);
+
+    //первые коэффициенты (1 + 2x)^10
+    ASSERT_EQUAL(Polynomial<complex<long double>>({1, 2}).PowMod(10, 4),
+                 Polynomial<complex<long double>>({1, 20, 180, 960}));
+    ASSERT_EQUAL(p2.PowMod(7, 43), p2 ^ 7);
+    ASSERT_EQUAL(p2.PowMod(0, 3), Polynomial<complex<long double>>({1, 0, 0}));
+
+    //n = 0 и пустые множители дают пустой ряд
+    Polynomial<complex<long double>> empty(vector<complex<long double>>{});
+    ASSERT_EQUAL(p1.MultiplyLow(p2, 0).GetDegree(), 0u);
+    ASSERT_EQUAL(p1.MultiplyLow(empty, 3), Polynomial<complex<long double>>({0, 0, 0}));
+    ASSERT_EQUAL(empty.MultiplyLow(p1, 2).GetDegree(), 2u);
+    ASSERT_EQUAL(p3.Log(0).GetDegree(), 0u);
+    ASSERT_EQUAL(x.Exp(0).GetDegree(), 0u);
+    ASSERT_EQUAL(p5.Sqrt(0).GetDegree(), 0u);
+    ASSERT_EQUAL(p2.PowMod(7, 0).GetDegree(), 0u);
+}
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "spectral_index.h"
+#include "accuracy.h"
+#include "instrumentation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+const char kMagic[8] = {'F', 'F', 'T', 'S', 'I', 'D', 'X', '\0'};
+
+struct IndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t element_size;
+  uint64_t block_length;
+  uint64_t text_size;
+  double max_block_norm;
+  uint64_t reserved[3];
+};
+static_assert(sizeof(IndexHeader) == 64, "index header must stay 64 bytes");
+
+using Complex = SubstringMatching::SpectralIndex::Complex;
+
+[[noreturn]] void ThrowIndexError(const std::string& path, const std::string& message) {
+    std::ostringstream os;
+    os << "Exception thrown in SpectralIndex, " << path << ": " << message << "\n";
+    throw std::runtime_error(os.str());
+}
+
+size_t GetBlockCount(size_t text_size, size_t block_length) {
+    return (text_size + block_length - 1) / block_length;
+}
+
+//заголовок файла, уже проверенного OpenIndex
+const IndexHeader& GetHeader(const OutOfCore::MappedFile& file) {
+    return *reinterpret_cast<const IndexHeader*>(file.Data());
+}
+
+//отображает файл индекса, проверив заголовок и размер один раз
+OutOfCore::MappedFile OpenIndex(const std::string& path) {
+    OutOfCore::MappedFile file(path);
+    if (file.Size() < sizeof(IndexHeader)) {
+        ThrowIndexError(file.GetPath(), "file is too short for an index header");
+    }
+    const IndexHeader& header = GetHeader(file);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        ThrowIndexError(file.GetPath(), "not a spectral index");
+    }
+    if (header.version != SubstringMatching::kSpectralIndexVersion ||
+        header.element_size != sizeof(Complex)) {
+        std::ostringstream os;
+        os << "unsupported index version " << header.version
+           << " with element size " << header.element_size;
+        ThrowIndexError(file.GetPath(), os.str());
+    }
+    size_t block_length = header.block_length;
+    if (block_length == 0 || (block_length & (block_length - 1)) != 0) {
+        ThrowIndexError(file.GetPath(), "block length is not a power of two");
+    }
+    size_t expected_size = sizeof(IndexHeader) +
+        GetBlockCount(header.text_size, block_length) * 2 * block_length * sizeof(Complex);
+    if (file.Size() != expected_size) {
+        ThrowIndexError(file.GetPath(), "file size does not match the header");
+    }
+    return file;
+}
+
+//спектр куска текста [begin, begin + block_length), дополненного нулями до 2 * block_length
+void TransformBlock(std::string_view text, size_t begin, size_t block_length,
+                    const FFT::Plan<Complex>& plan, std::vector<Complex>& spectrum, double& norm) {
+    spectrum.assign(2 * block_length, 0);
+    size_t end = std::min(text.size(), begin + block_length);
+    double sum = 0;
+    for (size_t i = begin; i < end; ++i) {
+        double value = static_cast<unsigned char>(text[i]) + 1;
+        spectrum[i - begin] = Complex(value, value * value);
+        sum += std::norm(spectrum[i - begin]);
+    }
+    norm = std::sqrt(sum);
+    plan.Forward(spectrum.data());
+}
+
+//волна кусков, которые считаются параллельно
+size_t GetWaveSize(ThreadPool* pool) {
+    return pool == nullptr ? 1 : 4 * pool->GetThreadCount();
+}
+
+template <typename F>
+void ForEachInWave(size_t count, ThreadPool* pool, F func) {
+    if (pool != nullptr) {
+        pool->ParallelFor(0, count, func);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+    }
+}
+}
+
+namespace SubstringMatching {
+void SpectralIndex::Build(std::string_view text, const std::string& path,
+                          size_t block_length, ThreadPool* pool) {
+    INSTRUMENT_SCOPE("SpectralIndex::Build", Complex, text.size());
+    size_t rounded = 1;
+    while (rounded < block_length) {
+        rounded *= 2;
+    }
+    block_length = rounded;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        ThrowIndexError(path, "cannot open for writing");
+    }
+    IndexHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kSpectralIndexVersion;
+    header.element_size = sizeof(Complex);
+    header.block_length = block_length;
+    header.text_size = text.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    FFT::Plan<Complex> plan(2 * block_length);
+    size_t block_count = GetBlockCount(text.size(), block_length);
+    size_t wave = GetWaveSize(pool);
+    std::vector<std::vector<Complex>> spectra(std::min(wave, block_count));
+    std::vector<double> norms(spectra.size());
+    for (size_t first = 0; first < block_count; first += wave) {
+        size_t count = std::min(wave, block_count - first);
+        ForEachInWave(count, pool, [&](size_t index) {
+            TransformBlock(text, (first + index) * block_length, block_length, plan,
+                           spectra[index], norms[index]);
+        });
+        for (size_t index = 0; index < count; ++index) {
+            out.write(reinterpret_cast<const char*>(spectra[index].data()),
+                      spectra[index].size() * sizeof(Complex));
+            header.max_block_norm = std::max(header.max_block_norm, norms[index]);
+        }
+    }
+
+    //норма известна только в конце, заголовок переписываем
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (!out) {
+        ThrowIndexError(path, "write failed");
+    }
+}
+
+SpectralIndex::SpectralIndex(const std::string& path)
+    : file_(OpenIndex(path)),
+      block_length_(GetHeader(file_).block_length),
+      text_size_(GetHeader(file_).text_size),
+      block_count_(GetBlockCount(text_size_, block_length_)),
+      max_block_norm_(GetHeader(file_).max_block_norm),
+      plan_(2 * block_length_) {
+}
+
+const SpectralIndex::Complex* SpectralIndex::GetSpectrum(size_t block) const {
+    return reinterpret_cast<const Complex*>(file_.Data() + sizeof(IndexHeader)) +
+        block * 2 * block_length_;
+}
+
+std::vector<size_t> SpectralIndex::FindMatches(std::string_view pattern,
+                                               std::optional<char> wildcard,
+                                               ThreadPool* pool) const {
+    std::vector<size_t> result;
+    size_t pattern_size = pattern.size();
+    if (pattern.empty() || pattern_size > text_size_) {
+        return result;
+    }
+    if (pattern_size > block_length_ + 1) {
+        std::ostringstream os;
+        os << "pattern of length " << pattern_size << " is longer than block length + 1 = "
+           << block_length_ + 1;
+        ThrowIndexError(file_.GetPath(), os.str());
+    }
+    INSTRUMENT_SCOPE("SpectralIndex::FindMatches", Complex, text_size_);
+
+    //ядро то же, что в PatternSpectrum: развернутый шаблон -2 * p^2 - i * p
+    size_t length = 2 * block_length_;
+    std::vector<Complex> kernel(length);
+    double cube_sum = 0, kernel_norm = 0;
+    for (size_t j = 0; j < pattern_size; ++j) {
+        char symbol = pattern[pattern_size - 1 - j];
+        double value = symbol == wildcard ? 0 : static_cast<unsigned char>(symbol) + 1;
+        kernel[j] = Complex(-2 * value * value, -value);
+        cube_sum += value * value * value;
+        kernel_norm += std::norm(kernel[j]);
+    }
+    plan_.Forward(kernel.data());
+
+    //свертка куска b длины B + m - 1 попадает в позиции [bB, bB + 2B) полной свертки,
+    //вторая половина переносится к следующему куску
+    std::vector<double> carry(block_length_);
+    size_t last = text_size_ - pattern_size;
+    size_t wave = GetWaveSize(pool);
+    std::vector<std::vector<Complex>> products(std::min(wave, block_count_));
+    bool check_accuracy = Accuracy::IsEnabled();
+    double max_distance = 0;
+    for (size_t first = 0; first < block_count_; first += wave) {
+        size_t count = std::min(wave, block_count_ - first);
+        ForEachInWave(count, pool, [&](size_t index) {
+            const Complex* spectrum = GetSpectrum(first + index);
+            std::vector<Complex>& product = products[index];
+            product.resize(length);
+            for (size_t k = 0; k < length; ++k) {
+                product[k] = spectrum[k] * kernel[k];
+            }
+            plan_.Inverse(product.data());
+        });
+
+        for (size_t index = 0; index < count; ++index) {
+            const std::vector<Complex>& product = products[index];
+            size_t block_begin = (first + index) * block_length_;
+            for (size_t n = 0; n < block_length_; ++n) {
+                double value = cube_sum + carry[n] + std::real(product[n]);
+                carry[n] = std::real(product[block_length_ + n]);
+                //позиция n куска - конец окна, начинающегося в block_begin + n - (m - 1)
+                size_t end = block_begin + n;
+                if (end + 1 < pattern_size || end + 1 - pattern_size > last) {
+                    continue;
+                }
+                if (check_accuracy) {
+                    max_distance = std::max(max_distance, std::abs(value - std::round(value)));
+                }
+                if (std::round(value) == 0) {
+                    result.push_back(end + 1 - pattern_size);
+                }
+            }
+        }
+    }
+
+    if (check_accuracy) {
+        //окно задевает не больше двух кусков
+        double error_bound = 2 * 5 * std::numeric_limits<double>::epsilon() *
+            std::log2(double(length)) * max_block_norm_ * std::sqrt(kernel_norm);
+        Accuracy::Record("SpectralIndex::FindMatches", text_size_, max_distance, error_bound);
+    }
+    return result;
+}
+} // namespace SubstringMatching
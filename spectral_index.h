@@ -0,0 +1,70 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fft.h"
+#include "out_of_core.h"
+#include "thread_pool.h"
+
+// Индекс для многократного поиска шаблонов с джокерами в неизменном тексте.
+// Текст режется на куски длины B без перекрытия, каждый кусок кодируется так же,
+// как в PatternSpectrum (t + i * t^2), дополняется нулями до 2B и преобразуется.
+// Спектры пишутся в файл, который при поиске отображается в память без копирования,
+// так что запрос преобразует только шаблон, а страницы индекса общие
+// для всех процессов. Свертки кусков складываются с перекрытием (overlap-add),
+// поэтому шаблон не длиннее B + 1.
+//
+// Формат файла (порядок байт - родной для машины, на которой строили):
+//   64 байта заголовка: "FFTSIDX\0", версия, размер элемента спектра, B,
+//   длина текста, наибольшая норма кодированного куска;
+//   затем ceil(длина текста / B) спектров по 2B значений std::complex<double>
+namespace SubstringMatching {
+const uint32_t kSpectralIndexVersion = 1;
+
+const size_t kSpectralIndexBlockLength = 2048;
+
+class SpectralIndex {
+ public:
+  using Complex = std::complex<double>;
+
+  // Строит индекс text в файле path, block_length округляется вверх до степени двойки
+  static void Build(std::string_view text, const std::string& path,
+                    size_t block_length = kSpectralIndexBlockLength,
+                    ThreadPool* pool = nullptr);
+
+  // Открывает индекс, выбрасывает std::runtime_error, если файл - не индекс
+  // этой версии или обрезан
+  explicit SpectralIndex(const std::string& path);
+
+  size_t GetTextSize() const {
+      return text_size_;
+  }
+
+  size_t GetBlockLength() const {
+      return block_length_;
+  }
+
+  // Все вхождения pattern в порядке возрастания, без wildcard - поиск подстроки
+  std::vector<size_t> FindMatches(std::string_view pattern, std::optional<char> wildcard = '?',
+                                  ThreadPool* pool = nullptr) const;
+
+ private:
+  const Complex* GetSpectrum(size_t block) const;
+
+  OutOfCore::MappedFile file_;
+  size_t block_length_;
+  size_t text_size_;
+  size_t block_count_;
+  double max_block_norm_;
+  FFT::Plan<Complex> plan_;
+};
+
+//Тесты
+void TestSpectralIndex();
+} // namespace SubstringMatching
@@ -0,0 +1,66 @@
+#include "spectral_index.h"
+#include "substring_matching.h"
+#include "test_runner.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace SubstringMatching {
+void TestSpectralIndex() {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "fft_spectral_index_test").string();
+
+    std::string text;
+    for (size_t i = 0; i < 3000; ++i) {
+        text.push_back("ab\ncd\xf0"[(i * i + i / 7) % 6]);
+    }
+    ThreadPool pool(2);
+    SpectralIndex::Build(text, path, 50, &pool);
+
+    {
+        SpectralIndex index(path);
+        ASSERT_EQUAL(index.GetBlockLength(), 64u);
+        ASSERT_EQUAL(index.GetTextSize(), text.size());
+        ASSERT_EQUAL(std::filesystem::file_size(path), 64 + 47 * 128 * sizeof(SpectralIndex::Complex));
+
+        std::vector<std::string> patterns = {"a", "?", "\nc", "a?\n", "c\xf0?a",
+                                             std::string(65, '?'), text.substr(100, 65)};
+        for (const auto& pattern : patterns) {
+            std::vector<size_t> expected = FindMatches(text, pattern);
+            ASSERT_EQUAL(index.FindMatches(pattern), expected);
+            ASSERT_EQUAL(index.FindMatches(pattern, '?', &pool), expected);
+        }
+        ASSERT_EQUAL(index.FindMatches("\nc", std::nullopt), FindSubstrings(text, "\nc"));
+        ASSERT(index.FindMatches("").empty());
+
+        bool thrown = false;
+        try {
+            index.FindMatches(std::string(66, 'a'));
+        } catch (std::runtime_error&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+
+    //обрезанный файл и чужой формат не открываются
+    std::filesystem::resize_file(path, 1000);
+    bool thrown = false;
+    try {
+        SpectralIndex index(path);
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+
+    std::ofstream(path, std::ios::trunc) << std::string(100, 'x');
+    thrown = false;
+    try {
+        SpectralIndex index(path);
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+
+    std::filesystem::remove(path);
+}
+} // namespace SubstringMatching
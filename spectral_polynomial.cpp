@@ -0,0 +1,160 @@
+#include "spectral_polynomial.h"
+#include "fft.h"
+
+namespace {
+size_t RoundUpToPowerOfTwo(size_t degree) {
+    size_t length = 1;
+    while (length < degree) {
+        length *= 2;
+    }
+    return length;
+}
+}
+
+template <typename T>
+SpectralPolynomial<T>::SpectralPolynomial(const Polynomial<T>& polynomial,
+                                          size_t transform_length)
+    : degree_(polynomial.GetDegree()) {
+    size_t length = RoundUpToPowerOfTwo(std::max(transform_length, degree_));
+    values_ = FFT::FastFourierTransform(FFT::AddPadding<T>(polynomial.GetCoefficients(), length));
+}
+
+template <typename T>
+SpectralPolynomial<T>::SpectralPolynomial(const Polynomial<T>& polynomial)
+    : SpectralPolynomial(polynomial, polynomial.GetDegree()) {
+}
+
+template <typename T>
+Polynomial<T> SpectralPolynomial<T>::ToPolynomial() const {
+    std::vector<T> coefficients = FFT::FastInverseFourierTransform(values_);
+    coefficients.resize(degree_);
+    return Polynomial<T>(coefficients);
+}
+
+template <typename T>
+void SpectralPolynomial<T>::Retransform(size_t new_length) {
+    new_length = RoundUpToPowerOfTwo(std::max(new_length, degree_));
+    if (new_length != values_.size()) {
+        *this = SpectralPolynomial(ToPolynomial(), new_length);
+    }
+}
+
+template <typename T>
+const SpectralPolynomial<T>& SpectralPolynomial<T>::Align(
+    const SpectralPolynomial& other, size_t length,
+    std::optional<SpectralPolynomial>& storage) {
+    length = RoundUpToPowerOfTwo(std::max({length, values_.size(), other.values_.size()}));
+    Retransform(length);
+    if (other.values_.size() == length) {
+        return other;
+    }
+    storage = other;
+    storage->Retransform(length);
+    return *storage;
+}
+
+template <typename T>
+SpectralPolynomial<T>& SpectralPolynomial<T>::operator+=(const SpectralPolynomial& other) {
+    std::optional<SpectralPolynomial> storage;
+    const SpectralPolynomial& addend = Align(other, 0, storage);
+
+    for (size_t i = 0; i < values_.size(); ++i) {
+        values_[i] += addend.values_[i];
+    }
+    degree_ = std::max(degree_, other.degree_);
+    return *this;
+}
+
+template <typename T>
+SpectralPolynomial<T>& SpectralPolynomial<T>::operator-=(const SpectralPolynomial& other) {
+    std::optional<SpectralPolynomial> storage;
+    const SpectralPolynomial& subtrahend = Align(other, 0, storage);
+
+    for (size_t i = 0; i < values_.size(); ++i) {
+        values_[i] -= subtrahend.values_[i];
+    }
+    degree_ = std::max(degree_, other.degree_);
+    return *this;
+}
+
+template <typename T>
+SpectralPolynomial<T>& SpectralPolynomial<T>::operator*=(const SpectralPolynomial& other) {
+    //если произведение не помещается в текущую длину, циклическая свертка
+    //завернула бы старшие коэффициенты на младшие, поэтому увеличиваем длину;
+    //у произведения с пустым множителем коэффициентов нет, как у MultiplyNaive
+    size_t future_degree = degree_ == 0 || other.degree_ == 0
+                           ? 0 : degree_ + other.degree_ - 1;
+
+    std::optional<SpectralPolynomial> storage;
+    const SpectralPolynomial& factor = Align(other, future_degree, storage);
+
+    for (size_t i = 0; i < values_.size(); ++i) {
+        values_[i] *= factor.values_[i];
+    }
+    degree_ = future_degree;
+    return *this;
+}
+
+template <typename T>
+SpectralPolynomial<T>& SpectralPolynomial<T>::operator+=(const T& scalar) {
+    for (auto& value : values_) {
+        value += scalar;
+    }
+    degree_ = std::max<size_t>(degree_, 1);
+    return *this;
+}
+
+template <typename T>
+SpectralPolynomial<T>& SpectralPolynomial<T>::operator-=(const T& scalar) {
+    return *this += -scalar;
+}
+
+template <typename T>
+SpectralPolynomial<T>& SpectralPolynomial<T>::operator*=(const T& scalar) {
+    for (auto& value : values_) {
+        value *= scalar;
+    }
+    return *this;
+}
+
+template <typename T>
+SpectralPolynomial<T>& SpectralPolynomial<T>::operator/=(const T& scalar) {
+    for (auto& value : values_) {
+        value /= scalar;
+    }
+    return *this;
+}
+
+template <typename T>
+const SpectralPolynomial<T> SpectralPolynomial<T>::operator+(const SpectralPolynomial& other) const {
+    SpectralPolynomial<T> result = *this;
+    return result += other;
+}
+
+template <typename T>
+const SpectralPolynomial<T> SpectralPolynomial<T>::operator-(const SpectralPolynomial& other) const {
+    SpectralPolynomial<T> result = *this;
+    return result -= other;
+}
+
+template <typename T>
+const SpectralPolynomial<T> SpectralPolynomial<T>::operator*(const SpectralPolynomial& other) const {
+    SpectralPolynomial<T> result = *this;
+    return result *= other;
+}
+
+template <typename T>
+const SpectralPolynomial<T> SpectralPolynomial<T>::operator*(const T& scalar) const {
+    SpectralPolynomial<T> result = *this;
+    return result *= scalar;
+}
+
+template <typename T>
+const SpectralPolynomial<T> SpectralPolynomial<T>::operator-() const {
+    SpectralPolynomial<T> result = *this;
+    return result *= T(-1);
+}
+
+template class SpectralPolynomial<std::complex<float>>;
+template class SpectralPolynomial<std::complex<double>>;
+template class SpectralPolynomial<std::complex<long double>>;
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <complex>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
+#include "polynomial.h"
+
+// Многочлен, хранящийся значениями в корнях степени n из 1 (n - степень двойки).
+// Сложение, вычитание, умножение и операции со скаляром выполняются поточечно за O(n),
+// без возврата к коэффициентам. Если произведение не помещается в n значений,
+// оба множителя заново преобразуются к большей длине
+template <typename T>
+class SpectralPolynomial {
+ public:
+  // Значения polynomial в корнях степени transform_length из 1,
+  // transform_length округляется вверх до степени двойки, не меньшей степени многочлена
+  SpectralPolynomial(const Polynomial<T>& polynomial, size_t transform_length);
+
+  // Наименьшая подходящая длина преобразования
+  explicit SpectralPolynomial(const Polynomial<T>& polynomial);
+
+  SpectralPolynomial(const SpectralPolynomial&) = default;
+  SpectralPolynomial(SpectralPolynomial&&) noexcept = default;
+
+  SpectralPolynomial& operator=(const SpectralPolynomial&) = default;
+  SpectralPolynomial& operator=(SpectralPolynomial&&) noexcept = default;
+
+  // Количество коэффициентов, как у Polynomial::GetDegree
+  size_t GetDegree() const {
+      return degree_;
+  }
+
+  size_t GetTransformLength() const {
+      return values_.size();
+  }
+
+  const std::vector<T>& GetValues() const {
+      return values_;
+  }
+
+  // Обратное преобразование к коэффициентам
+  Polynomial<T> ToPolynomial() const;
+
+  explicit operator Polynomial<T>() const {
+      return ToPolynomial();
+  }
+
+  // Переходит к длине преобразования не меньше new_length через коэффициенты
+  void Retransform(size_t new_length);
+
+  SpectralPolynomial& operator+=(const SpectralPolynomial& other);
+
+  SpectralPolynomial& operator-=(const SpectralPolynomial& other);
+
+  SpectralPolynomial& operator*=(const SpectralPolynomial& other);
+
+  // Прибавление константы меняет все значения на одну и ту же величину
+  SpectralPolynomial& operator+=(const T& scalar);
+
+  SpectralPolynomial& operator-=(const T& scalar);
+
+  SpectralPolynomial& operator*=(const T& scalar);
+
+  SpectralPolynomial& operator/=(const T& scalar);
+
+  const SpectralPolynomial operator+(const SpectralPolynomial& other) const;
+
+  const SpectralPolynomial operator-(const SpectralPolynomial& other) const;
+
+  const SpectralPolynomial operator*(const SpectralPolynomial& other) const;
+
+  const SpectralPolynomial operator*(const T& scalar) const;
+
+  const SpectralPolynomial operator-() const;
+
+ private:
+  // Приводит длины преобразований this и other к общей, не меньшей length,
+  // копия other делается в storage, только если его длину нужно менять
+  const SpectralPolynomial& Align(const SpectralPolynomial& other, size_t length,
+                                  std::optional<SpectralPolynomial>& storage);
+
+  std::vector<T> values_;
+  size_t degree_;
+};
+
+//Тесты для SpectralPolynomial
+namespace SpectralPolynomialTests {
+void Conversion();
+void Arithmetic();
+void Growth();
+} // namespace SpectralPolynomialTests
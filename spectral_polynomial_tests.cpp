@@ -0,0 +1,68 @@
+#include "spectral_polynomial.h"
+#include "test_runner.h"
+
+namespace SpectralPolynomialTests {
+void Conversion() {
+    using std::complex;
+
+    Polynomial<complex<long double>> p1({1, 2, 3});
+    SpectralPolynomial<complex<long double>> s1(p1);
+    ASSERT_EQUAL(s1.GetTransformLength(), 4u);
+    ASSERT_EQUAL(s1.GetDegree(), 3u);
+    ASSERT_EQUAL(s1.ToPolynomial(), p1);
+
+    SpectralPolynomial<complex<long double>> s2(p1, 30);
+    ASSERT_EQUAL(s2.GetTransformLength(), 32u);
+    ASSERT_EQUAL(static_cast<Polynomial<complex<long double>>>(s2), p1);
+}
+
+void Arithmetic() {
+    using std::complex;
+
+    Polynomial<complex<long double>>
+        p1({7, 2, 13, 6}),
+        p2({3, 1, 0, 0, 5, 8, 9}),
+        p3({1, 1});
+
+    SpectralPolynomial<complex<long double>> s1(p1, 16), s2(p2, 16), s3(p3, 16);
+
+    ASSERT_EQUAL((s1 * s2 + s3).ToPolynomial(), p1 * p2 + p3);
+    ASSERT_EQUAL((s1 * s2 - s3 * s1).ToPolynomial(), p1 * p2 - p3 * p1);
+    ASSERT_EQUAL((-s1).ToPolynomial(), -p1);
+
+    SpectralPolynomial<complex<long double>> s4 = s3;
+    s4 *= complex<long double>(3);
+    s4 += complex<long double>(2);
+    ASSERT_EQUAL(s4.ToPolynomial(), Polynomial<complex<long double>>({5, 3}));
+    s4 -= complex<long double>(2);
+    s4 /= complex<long double>(3);
+    ASSERT_EQUAL(s4.ToPolynomial(), p3);
+}
+
+void Growth() {
+    using std::complex;
+
+    Polynomial<complex<long double>> p1({1, 2}), p2({1, 1, 1});
+
+    //произведение не помещается в 4 значения и должно перейти к длине 8,
+    //без этого коэффициенты завернулись бы циклически
+    SpectralPolynomial<complex<long double>> s1(p1), s2(p2);
+    SpectralPolynomial<complex<long double>> product = s1;
+    for (size_t i = 0; i < 5; ++i) {
+        product *= s1;
+    }
+    ASSERT_EQUAL(product.ToPolynomial(), p1 ^ 6);
+    ASSERT_EQUAL(product.GetTransformLength(), 8u);
+
+    //разные длины выравниваются перед сложением
+    ASSERT_EQUAL((product + s2).ToPolynomial(), (p1 ^ 6) + p2);
+    ASSERT_EQUAL((s2 * product).ToPolynomial(), (p1 ^ 6) * p2);
+
+    //пустой множитель: произведение пусто, длина не уходит в SIZE_MAX
+    SpectralPolynomial<complex<long double>> empty(
+        Polynomial<complex<long double>>(std::vector<complex<long double>>{}));
+    ASSERT_EQUAL((empty * empty).GetDegree(), 0u);
+    ASSERT_EQUAL((empty * s2).GetDegree(), 0u);
+    ASSERT_EQUAL((s2 * empty).ToPolynomial().GetDegree(), 0u);
+}
+} // namespace SpectralPolynomialTests
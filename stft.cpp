@@ -0,0 +1,195 @@
+#include "stft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+//кадры раздаются потокам пачками, чтобы не платить за синхронизацию на каждый кадр
+const size_t kFramesPerTask = 16;
+
+//вызывает func(i) для i из [0, count) пачками, в пуле или в текущем потоке
+template <typename F>
+void ForEachFrame(size_t count, ThreadPool* pool, F func) {
+    auto batch = [count, &func](size_t index) {
+        size_t end = std::min(count, (index + 1) * kFramesPerTask);
+        for (size_t i = index * kFramesPerTask; i < end; ++i) {
+            func(i);
+        }
+    };
+    size_t batches = (count + kFramesPerTask - 1) / kFramesPerTask;
+    if (pool != nullptr) {
+        pool->ParallelFor(0, batches, batch);
+    } else {
+        for (size_t i = 0; i < batches; ++i) {
+            batch(i);
+        }
+    }
+}
+}
+
+template <typename T>
+ShortTimeFourierTransform<T>::ShortTimeFourierTransform(const std::vector<Real>& window,
+                                                        size_t hop)
+    : window_(window), hop_(hop), plan_(window.size()),
+      output_(window.size()), norm_(window.size()), frame_(window.size()) {
+    if (hop == 0 || hop > window.size()) {
+        std::ostringstream os;
+        os << "Exception thrown in ShortTimeFourierTransform, hop " << hop
+           << " must be positive and not greater than frame length " << window.size() << "\n";
+        throw std::runtime_error(os.str());
+    }
+}
+
+template <typename T>
+void ShortTimeFourierTransform<T>::AnalyzeFrame(const T* signal, T* spectrum) const {
+    for (size_t i = 0; i < window_.size(); ++i) {
+        spectrum[i] = signal[i] * window_[i];
+    }
+    plan_.Forward(spectrum);
+}
+
+template <typename T>
+void ShortTimeFourierTransform<T>::AccumulateFrame(const T* frame, T* output, Real* norm) const {
+    for (size_t i = 0; i < window_.size(); ++i) {
+        output[i] += frame[i] * window_[i];
+        norm[i] += window_[i] * window_[i];
+    }
+}
+
+template <typename T>
+std::vector<T> ShortTimeFourierTransform<T>::Normalize(const T* output, const Real* norm,
+                                                      size_t size) const {
+    std::vector<T> result(size);
+    for (size_t i = 0; i < size; ++i) {
+        if (norm[i] > std::numeric_limits<Real>::epsilon()) {
+            result[i] = output[i] / norm[i];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<std::vector<T>> ShortTimeFourierTransform<T>::Analyze(const std::vector<T>& signal,
+                                                                  ThreadPool* pool) const {
+    size_t length = window_.size();
+    size_t count = signal.size() >= length ? (signal.size() - length) / hop_ + 1 : 0;
+
+    std::vector<std::vector<T>> result(count, std::vector<T>(length));
+    ForEachFrame(count, pool, [this, &signal, &result](size_t frame) {
+        AnalyzeFrame(signal.data() + frame * hop_, result[frame].data());
+    });
+    return result;
+}
+
+template <typename T>
+std::vector<T> ShortTimeFourierTransform<T>::Synthesize(const std::vector<std::vector<T>>& frames,
+                                                        ThreadPool* pool) const {
+    if (frames.empty()) {
+        return {};
+    }
+    size_t length = window_.size();
+    for (const auto& frame : frames) {
+        if (frame.size() != length) {
+            std::ostringstream os;
+            os << "Exception thrown in ShortTimeFourierTransform::Synthesize, frame of length "
+               << frame.size() << " does not match frame length " << length << "\n";
+            throw std::runtime_error(os.str());
+        }
+    }
+
+    //обратные преобразования независимы и идут параллельно,
+    //сложение с перекрытием - последовательно
+    std::vector<std::vector<T>> time_frames = frames;
+    ForEachFrame(frames.size(), pool, [this, &time_frames](size_t frame) {
+        plan_.Inverse(time_frames[frame].data());
+    });
+
+    size_t size = (frames.size() - 1) * hop_ + length;
+    std::vector<T> output(size);
+    std::vector<Real> norm(size);
+    for (size_t frame = 0; frame < frames.size(); ++frame) {
+        AccumulateFrame(time_frames[frame].data(), output.data() + frame * hop_,
+                        norm.data() + frame * hop_);
+    }
+    return Normalize(output.data(), norm.data(), size);
+}
+
+template <typename T>
+std::vector<std::vector<T>> ShortTimeFourierTransform<T>::Push(const std::vector<T>& chunk) {
+    input_.insert(input_.end(), chunk.begin(), chunk.end());
+
+    std::vector<std::vector<T>> result;
+    size_t begin = 0;
+    for (; begin + window_.size() <= input_.size(); begin += hop_) {
+        result.emplace_back(window_.size());
+        AnalyzeFrame(input_.data() + begin, result.back().data());
+    }
+
+    //следующий кадр начинается с begin, все что раньше уже не понадобится
+    input_.erase(input_.begin(), input_.begin() + std::min(begin, input_.size()));
+    return result;
+}
+
+template <typename T>
+std::vector<T> ShortTimeFourierTransform<T>::PushSpectrum(const std::vector<T>& spectrum) {
+    if (spectrum.size() != window_.size()) {
+        std::ostringstream os;
+        os << "Exception thrown in ShortTimeFourierTransform::PushSpectrum, frame of length "
+           << spectrum.size() << " does not match frame length " << window_.size() << "\n";
+        throw std::runtime_error(os.str());
+    }
+    synthesizing_ = true;
+
+    std::copy(spectrum.begin(), spectrum.end(), frame_.begin());
+    plan_.Inverse(frame_.data());
+    AccumulateFrame(frame_.data(), output_.data(), norm_.data());
+
+    //первые hop отсчетов больше не перекрываются следующими кадрами
+    std::vector<T> result = Normalize(output_.data(), norm_.data(), hop_);
+    std::fill(std::copy(output_.begin() + hop_, output_.end(), output_.begin()),
+              output_.end(), T(0));
+    std::fill(std::copy(norm_.begin() + hop_, norm_.end(), norm_.begin()),
+              norm_.end(), Real(0));
+    return result;
+}
+
+template <typename T>
+std::vector<T> ShortTimeFourierTransform<T>::FlushSynthesis() {
+    if (!synthesizing_) {
+        return {};
+    }
+    std::vector<T> result = Normalize(output_.data(), norm_.data(), window_.size() - hop_);
+    std::fill(output_.begin(), output_.end(), T(0));
+    std::fill(norm_.begin(), norm_.end(), Real(0));
+    synthesizing_ = false;
+    return result;
+}
+
+template <typename T>
+void ShortTimeFourierTransform<T>::Reset() {
+    input_.clear();
+    std::fill(output_.begin(), output_.end(), T(0));
+    std::fill(norm_.begin(), norm_.end(), Real(0));
+    synthesizing_ = false;
+}
+
+template <typename Real>
+std::vector<Real> HannWindow(size_t length) {
+    static const Real dPI = 2 * std::acos(Real(-1));
+    std::vector<Real> result(length);
+    for (size_t i = 0; i < length; ++i) {
+        result[i] = Real(0.5) - Real(0.5) * std::cos(dPI * i / length);
+    }
+    return result;
+}
+
+template class ShortTimeFourierTransform<std::complex<float>>;
+template class ShortTimeFourierTransform<std::complex<double>>;
+template class ShortTimeFourierTransform<std::complex<long double>>;
+
+template std::vector<float> HannWindow<float>(size_t length);
+template std::vector<double> HannWindow<double>(size_t length);
+template std::vector<long double> HannWindow<long double>(size_t length);
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <complex>
+#include <cstdlib>
+#include <vector>
+
+#include "fft.h"
+#include "thread_pool.h"
+
+// Оконное преобразование Фурье (STFT) и обратное к нему.
+// Кадр длины window.size() (степень двойки) берется с шагом hop, умножается на окно
+// и преобразуется одним заранее построенным FFT::Plan. Обратное преобразование -
+// взвешенное сложение с перекрытием: кадры после обратного FFT снова умножаются
+// на окно, суммируются и делятся на сумму квадратов окна в каждой точке.
+// Потоковые Push/PushSpectrum хранят только O(window.size()) отсчетов
+// и не выделяют память на кадр, кроме самих возвращаемых векторов
+template <typename T>
+class ShortTimeFourierTransform {
+ public:
+  using Real = typename T::value_type;
+
+  ShortTimeFourierTransform(const std::vector<Real>& window, size_t hop);
+
+  size_t GetFrameLength() const {
+      return window_.size();
+  }
+
+  size_t GetHop() const {
+      return hop_;
+  }
+
+  // Спектры всех кадров, целиком лежащих в signal. Если задан pool,
+  // кадры преобразуются пачками параллельно
+  std::vector<std::vector<T>> Analyze(const std::vector<T>& signal,
+                                      ThreadPool* pool = nullptr) const;
+
+  // Восстанавливает сигнал длины (frames.size() - 1) * hop + frame_length
+  std::vector<T> Synthesize(const std::vector<std::vector<T>>& frames,
+                            ThreadPool* pool = nullptr) const;
+
+  // Потоковый анализ: добавляет отсчеты и возвращает спектры всех кадров,
+  // которые стали полными
+  std::vector<std::vector<T>> Push(const std::vector<T>& chunk);
+
+  // Потоковый синтез: добавляет спектр очередного кадра и возвращает
+  // следующие hop окончательных отсчетов
+  std::vector<T> PushSpectrum(const std::vector<T>& spectrum);
+
+  // Завершает потоковый синтез: возвращает оставшиеся frame_length - hop отсчетов
+  std::vector<T> FlushSynthesis();
+
+  // Сбрасывает состояние потокового анализа и синтеза
+  void Reset();
+
+ private:
+  // Умножает frame_length отсчетов signal на окно и преобразует в spectrum
+  void AnalyzeFrame(const T* signal, T* spectrum) const;
+
+  // Добавляет кадр frame, уже возвращенный во временную область, к суммам output и norm
+  void AccumulateFrame(const T* frame, T* output, Real* norm) const;
+
+  // output[i] / norm[i], там где окна почти не перекрываются - 0
+  std::vector<T> Normalize(const T* output, const Real* norm, size_t size) const;
+
+  std::vector<Real> window_;
+  size_t hop_;
+  FFT::Plan<T> plan_;
+
+  // Состояние анализа: еще не разобранные отсчеты
+  std::vector<T> input_;
+  // Состояние синтеза: накопленные суммы кадров и квадратов окна
+  std::vector<T> output_;
+  std::vector<Real> norm_;
+  std::vector<T> frame_;
+  bool synthesizing_ = false;
+};
+
+// Периодическое окно Ханна длины length
+template <typename Real>
+std::vector<Real> HannWindow(size_t length);
+
+//Тесты для ShortTimeFourierTransform
+namespace ShortTimeFourierTransformTests {
+void AnalyzeAndSynthesize();
+void Streaming();
+} // namespace ShortTimeFourierTransformTests
@@ -0,0 +1,95 @@
+#include "stft.h"
+#include "test_runner.h"
+
+namespace ShortTimeFourierTransformTests {
+namespace {
+std::vector<std::complex<double>> MakeSignal(size_t size) {
+    std::vector<std::complex<double>> result(size);
+    for (size_t i = 0; i < size; ++i) {
+        result[i] = std::sin(0.05 * i) + 0.5 * std::cos(0.31 * i) + double(i % 7) / 7;
+    }
+    return result;
+}
+}
+
+void AnalyzeAndSynthesize() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-9;
+
+    const size_t length = 64, hop = 16;
+    ShortTimeFourierTransform<complex<double>> stft(HannWindow<double>(length), hop);
+    vector<complex<double>> signal = MakeSignal(1000);
+
+    vector<vector<complex<double>>> frames = stft.Analyze(signal);
+    ASSERT_EQUAL(frames.size(), (signal.size() - length) / hop + 1);
+
+    //кадр - это FFT отрезка сигнала, умноженного на окно
+    vector<double> window = HannWindow<double>(length);
+    vector<complex<double>> windowed(length);
+    for (size_t i = 0; i < length; ++i) {
+        windowed[i] = signal[3 * hop + i] * window[i];
+    }
+    ASSERT_VECTOR(frames[3], FFT::FastFourierTransform(windowed), error);
+
+    //параллельный анализ дает то же самое
+    ThreadPool pool(4);
+    vector<vector<complex<double>>> parallel_frames = stft.Analyze(signal, &pool);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        ASSERT_VECTOR(parallel_frames[i], frames[i], error);
+    }
+
+    //восстановление точное везде, кроме первого отсчета, где окно Ханна равно нулю
+    vector<complex<double>> restored = stft.Synthesize(frames, &pool);
+    ASSERT_EQUAL(restored.size(), (frames.size() - 1) * hop + length);
+    ASSERT_VECTOR(vector<complex<double>>(restored.begin() + 1, restored.end()),
+                  vector<complex<double>>(signal.begin() + 1, signal.begin() + restored.size()),
+                  error);
+
+    bool thrown = false;
+    try {
+        ShortTimeFourierTransform<complex<float>> wrong(HannWindow<float>(48), 16);
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+
+void Streaming() {
+    using std::complex;
+    using std::vector;
+
+    const long double error = 1.0e-9;
+
+    ShortTimeFourierTransform<complex<double>> stft(HannWindow<double>(32), 8);
+    vector<complex<double>> signal = MakeSignal(700);
+    vector<vector<complex<double>>> expected = stft.Analyze(signal);
+
+    //кусками разной длины
+    vector<vector<complex<double>>> frames;
+    size_t chunk = 1;
+    for (size_t begin = 0; begin < signal.size(); begin += chunk) {
+        chunk = chunk * 5 % 97;
+        size_t end = std::min(signal.size(), begin + chunk);
+        for (auto& frame : stft.Push({signal.begin() + begin, signal.begin() + end})) {
+            frames.push_back(std::move(frame));
+        }
+    }
+    ASSERT_EQUAL(frames.size(), expected.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        ASSERT_VECTOR(frames[i], expected[i], error);
+    }
+
+    vector<complex<double>> restored;
+    for (const auto& frame : frames) {
+        vector<complex<double>> samples = stft.PushSpectrum(frame);
+        ASSERT_EQUAL(samples.size(), stft.GetHop());
+        restored.insert(restored.end(), samples.begin(), samples.end());
+    }
+    vector<complex<double>> tail = stft.FlushSynthesis();
+    restored.insert(restored.end(), tail.begin(), tail.end());
+    ASSERT_VECTOR(restored, stft.Synthesize(frames), error);
+    ASSERT(stft.FlushSynthesis().empty());
+}
+} // namespace ShortTimeFourierTransformTests
@@ -1,15 +1,25 @@
 #include "substring_matching.h"
 #include "fft.h"
 #include "polynomial.h"
+#include "instrumentation.h"
+#include "accuracy.h"
 #include "test_runner.h"
 
+namespace {
+std::complex<long double> EncodeByte(char symbol) {
+    return static_cast<unsigned char>(symbol) + 1;
+}
+}
+
 namespace SubstringMatching {
 std::vector<size_t> FindSubstrings(const std::string& str,
                                    const std::string& pattern) {
     std::vector<size_t> result;
-    result.reserve(str.size() - pattern.size() + 1);
+    if (pattern.size() > str.size()) {
+        return result;
+    }
 
-    for (size_t i = 0; i < result.capacity(); ++i) {
+    for (size_t i = 0; i + pattern.size() <= str.size(); ++i) {
         bool substring_found = true;
         for (size_t j = 0; j < pattern.size(); ++j) {
             if (str[i + j] != pattern[j]) {
@@ -21,7 +31,6 @@ std::vector<size_t> FindSubstrings(const std::string& str,
         }
     }
 
-    result.shrink_to_fit();
     return result;
 }
 
@@ -31,17 +40,19 @@ std::vector<size_t> FindSubstringsFFT(const std::string& str,
     if (str.empty() || pattern.empty() || pattern.size() > str.size()) {
         return {};
     }
+    INSTRUMENT_SCOPE("SubstringMatching::FindSubstringsFFT", std::complex<long double>, str.size());
 
-    //закодируем строчки числами в ascii кодировке
+    //закодируем строчки числами: байт b - кодом b + 1,
+    //чтобы байты старше 127 не стали отрицательными
     //исходная строка - прямая, а подстрока - развернутая
-    //кажется, что такой конструктор сделает
-    //static_cast<std::complex<float>> к каждому элементу строки
-    std::vector<std::complex<long double>> str_(begin(str), end(str));
-    std::vector<std::complex<long double>> pattern_(rbegin(pattern), rend(pattern));
+    std::vector<std::complex<long double>> str_(str.size());
+    std::vector<std::complex<long double>> pattern_(pattern.size());
+    std::transform(begin(str), end(str), begin(str_), EncodeByte);
+    std::transform(rbegin(pattern), rend(pattern), begin(pattern_), EncodeByte);
 
     //вычислим сумму квадратов всех элементов для подстроки
     long double square_sum_pattern = std::accumulate(
-        begin(pattern_), end(pattern_), 0,
+        begin(pattern_), end(pattern_), 0.0L,
         [](const long double& curr_sum, const auto& elem) {
             return curr_sum + pow(std::real(elem), 2);
         }
@@ -56,7 +67,7 @@ std::vector<size_t> FindSubstringsFFT(const std::string& str,
 
     //вычислим сумму квадратов первых pattern_.size() элементов для строки
     long double first_m_square_sum_str = std::accumulate(
-        begin(str_), begin(str_) + pattern_.size(), 0,
+        begin(str_), begin(str_) + pattern_.size(), 0.0L,
         [](const long double& curr_sum, const std::complex<long double>& elem) {
           return curr_sum + pow(std::real(elem), 2);
         }
@@ -83,8 +94,18 @@ std::vector<size_t> FindSubstringsFFT(const std::string& str,
     //если квадрат разности равен нулю, то
     //подстрока в строке и исходная подстрока совпали
     //соберем ответ
+    if (Accuracy::IsEnabled()) {
+        //каждый шаг рекуррентной формулы добавляет погрешность двух коэффициентов
+        //произведения, домноженных на 2
+        double error_bound = 2 * (2 * sum_square_diff.size() - 1) *
+            Accuracy::ConvolutionErrorBound(str_, pattern_, 2 * str_.size());
+        Accuracy::Record("SubstringMatching::FindSubstringsFFT", str.size(),
+                         Accuracy::MaxDistanceToInteger(begin(sum_square_diff),
+                                                        end(sum_square_diff)),
+                         error_bound);
+    }
+
     std::vector<size_t> result;
-    result.reserve(sum_square_diff.size());
 
     for (size_t i = 0; i < sum_square_diff.size(); ++i) {
         if (std::round(sum_square_diff[i]) == 0) {
@@ -92,8 +113,6 @@ std::vector<size_t> FindSubstringsFFT(const std::string& str,
         }
     }
 
-    result.shrink_to_fit();
-
     return result;
 }
 
@@ -101,9 +120,11 @@ std::vector<size_t> FindMatches(const std::string& str,
                                 const std::string& pattern) {
 
     std::vector<size_t> result;
-    result.reserve(str.size() - pattern.size() + 1);
+    if (pattern.size() > str.size()) {
+        return result;
+    }
 
-    for (size_t i = 0; i < result.capacity(); ++i) {
+    for (size_t i = 0; i + pattern.size() <= str.size(); ++i) {
         bool substring_found = true;
         for (size_t j = 0; j < pattern.size(); ++j) {
             if (str[i + j] != pattern[j] && pattern[j] != '?') {
@@ -115,7 +136,6 @@ std::vector<size_t> FindMatches(const std::string& str,
         }
     }
 
-    result.shrink_to_fit();
     return result;
 }
 
@@ -130,14 +150,16 @@ std::vector<size_t> FindMatchesFFT(const std::string& str,
     if (str.empty() || pattern.empty() || pattern.size() > str.size()) {
         return {};
     }
+    INSTRUMENT_SCOPE("SubstringMatching::FindMatchesFFT", std::complex<long double>, str.size());
 
-    std::vector<std::complex<long double>> str_(begin(str), end(str));
-    std::vector<std::complex<long double>> pattern_(rbegin(pattern), rend(pattern));
+    std::vector<std::complex<long double>> str_(str.size());
+    std::vector<std::complex<long double>> pattern_(pattern.size());
     std::vector<std::complex<long double>> str_squared(str_.size());
     std::vector<std::complex<long double>> pattern_squared(pattern_.size());
 
-    std::for_each(begin(pattern_), end(pattern_), [](auto& elem){
-         elem = static_cast<char>(std::real(elem)) == '?' ? 0 : elem;
+    std::transform(begin(str), end(str), begin(str_), EncodeByte);
+    std::transform(rbegin(pattern), rend(pattern), begin(pattern_), [](char symbol) {
+        return symbol == '?' ? std::complex<long double>(0) : EncodeByte(symbol);
     });
 
     auto make_squared = [](const auto& elem) {
@@ -149,7 +171,7 @@ std::vector<size_t> FindMatchesFFT(const std::string& str,
 
     //вычислим сумму кубов всех элементов для подстроки
     long double cube_sum_pattern = std::accumulate(
-        begin(pattern_), end(pattern_), 0,
+        begin(pattern_), end(pattern_), 0.0L,
         [](const long double& curr_sum, const auto& elem) {
           return curr_sum + pow(std::real(elem), 3);
         }
@@ -186,8 +208,19 @@ std::vector<size_t> FindMatchesFFT(const std::string& str,
 
     //если зануляется элемент суммы,
     //то будет подстроки совпали с учетом джокеров
+    if (Accuracy::IsEnabled()) {
+        //шаг рекуррентной формулы: по два коэффициента каждого произведения
+        double error_bound = (2 * sum_square_diff.size() - 1) * (
+            Accuracy::ConvolutionErrorBound(str_squared, pattern_, 2 * str_.size()) +
+            2 * Accuracy::ConvolutionErrorBound(str_, pattern_squared, 2 * str_.size())
+        );
+        Accuracy::Record("SubstringMatching::FindMatchesFFT", str.size(),
+                         Accuracy::MaxDistanceToInteger(begin(sum_square_diff),
+                                                        end(sum_square_diff)),
+                         error_bound);
+    }
+
     std::vector<size_t> result;
-    result.reserve(sum_square_diff.size());
 
     for (size_t i = 0; i < sum_square_diff.size(); ++i) {
         if (std::round(sum_square_diff[i]) == 0) {
@@ -195,9 +228,506 @@ std::vector<size_t> FindMatchesFFT(const std::string& str,
         }
     }
 
-    result.shrink_to_fit();
+    return result;
 
+}
+
+size_t RoundBlockLength(size_t pattern_size, size_t block_length) {
+    size_t result = 1;
+    while (result < block_length || result < 2 * pattern_size) {
+        result *= 2;
+    }
     return result;
+}
+
+namespace {
+//Код байта в тексте и шаблоне
+long double GetCode(char symbol) {
+    return static_cast<unsigned char>(symbol) + 1;
+}
 
+//Код алфавита уже готов
+long double GetCode(uint32_t code) {
+    return code;
+}
+}
+
+template <typename T>
+BasicPatternSpectrum<T>::BasicPatternSpectrum(std::string_view pattern,
+                                              std::optional<char> wildcard, size_t block_length)
+    : pattern_size_(pattern.size()),
+      cube_sum_(0),
+      weights_(pattern.size()),
+      plan_(RoundBlockLength(pattern.size(), block_length)) {
+    std::vector<long double> codes(pattern.size());
+    for (size_t j = 0; j < pattern.size(); ++j) {
+        codes[j] = pattern[j] == wildcard ? 0 : GetCode(pattern[j]);
+    }
+    SetPattern(codes);
+}
+
+template <typename T>
+BasicPatternSpectrum<T>::BasicPatternSpectrum(const std::vector<uint32_t>& pattern,
+                                              size_t block_length)
+    : pattern_size_(pattern.size()),
+      cube_sum_(0),
+      weights_(pattern.size()),
+      plan_(RoundBlockLength(pattern.size(), block_length)) {
+    SetPattern(pattern);
+}
+
+template <typename T>
+template <typename Codes>
+void BasicPatternSpectrum<T>::SetPattern(const Codes& codes) {
+    if (pattern_size_ == 0) {
+        std::ostringstream os;
+        os << "Exception thrown in PatternSpectrum, pattern is empty\n";
+        throw std::runtime_error(os.str());
+    }
+
+    //шаблон разворачиваем, чтобы корреляция стала сверткой,
+    //sum p^3 копится в long double при любом T
+    using Real = typename T::value_type;
+    for (size_t j = 0; j < pattern_size_; ++j) {
+        long double value = codes[pattern_size_ - 1 - j];
+        weights_[j] = T(Real(-2 * value * value), Real(-value));
+        cube_sum_ += value * value * value;
+    }
+
+    kernel_.assign(GetBlockLength(), T(0));
+    std::copy(begin(weights_), end(weights_), begin(kernel_));
+    plan_.Forward(kernel_.data());
+}
+
+template <typename T>
+std::vector<size_t> BasicPatternSpectrum<T>::FindInBlock(std::string_view text, size_t begin,
+                                                         std::vector<Complex>& buffer) const {
+    return FindInCodes(text, begin, buffer);
+}
+
+template <typename T>
+std::vector<size_t> BasicPatternSpectrum<T>::FindInBlock(const std::vector<uint32_t>& text,
+                                                         size_t begin,
+                                                         std::vector<Complex>& buffer) const {
+    return FindInCodes(text, begin, buffer);
+}
+
+template <typename T>
+template <typename Text>
+std::vector<size_t> BasicPatternSpectrum<T>::FindInCodes(const Text& text, size_t begin,
+                                                         std::vector<Complex>& buffer) const {
+    std::vector<size_t> result;
+    if (text.size() < pattern_size_ || begin > text.size() - pattern_size_) {
+        return result;
+    }
+
+    using Real = typename T::value_type;
+    size_t length = GetBlockLength();
+    size_t end = std::min(text.size(), begin + length);
+    size_t last = std::min(begin + GetStep(), end - pattern_size_ + 1);
+
+    buffer.assign(length, T(0));
+    for (size_t i = begin; i < end; ++i) {
+        long double value = GetCode(text[i]);
+        buffer[i - begin] = T(Real(value), Real(value * value));
+    }
+    bool check_accuracy = Accuracy::IsEnabled();
+    double error_bound = 0;
+    if (check_accuracy) {
+        error_bound = Accuracy::ConvolutionErrorBound(buffer, weights_, length);
+    }
+
+    plan_.Forward(buffer.data());
+    for (size_t k = 0; k < length; ++k) {
+        buffer[k] *= kernel_[k];
+    }
+    plan_.Inverse(buffer.data());
+
+    //свертка в позиции i + pattern_size_ - 1 не заворачивается по кругу,
+    //пока вхождение целиком лежит в куске
+    double max_distance = 0;
+    for (size_t i = begin; i < last; ++i) {
+        long double value = cube_sum_ + std::real(buffer[i - begin + pattern_size_ - 1]);
+        if (check_accuracy) {
+            max_distance = std::max(max_distance, double(std::abs(value - std::round(value))));
+        }
+        if (std::round(value) == 0) {
+            result.push_back(i);
+        }
+    }
+    if (check_accuracy) {
+        Accuracy::Record("SubstringMatching::PatternSpectrum::FindInBlock", length,
+                         max_distance, error_bound);
+    }
+
+    return result;
+}
+
+namespace {
+//Вызывает visit(positions) для вхождений каждого куска по порядку, пока visit возвращает true.
+//Куски считаются волнами по wave штук, следующая волна не начинается,
+//если поиск остановлен в предыдущей
+template <typename Text, typename T, typename F>
+void ForEachBlock(const Text& str, const BasicPatternSpectrum<T>& spectrum, ThreadPool* pool,
+                  size_t wave, F visit) {
+    if (str.size() < spectrum.GetPatternSize()) {
+        return;
+    }
+    size_t step = spectrum.GetStep();
+    size_t blocks = (str.size() - spectrum.GetPatternSize()) / step + 1;
+    if (pool == nullptr) {
+        wave = 1;
+    }
+
+    std::vector<std::vector<size_t>> block_results(std::min(wave, blocks));
+    for (size_t first = 0; first < blocks; first += wave) {
+        size_t count = std::min(wave, blocks - first);
+        auto find = [&](size_t index) {
+            //рабочий массив один на поток, а не на кусок
+            thread_local std::vector<T> buffer;
+            block_results[index] = spectrum.FindInBlock(str, (first + index) * step, buffer);
+        };
+        if (pool != nullptr) {
+            pool->ParallelFor(0, count, find);
+        } else {
+            find(0);
+        }
+        for (size_t index = 0; index < count; ++index) {
+            if (!visit(block_results[index])) {
+                return;
+            }
+        }
+    }
+}
+
+//Волна для режимов с ранней остановкой: несколько кусков на поток,
+//чтобы ожидание самого медленного куска не съедало параллельность
+size_t GetWaveSize(ThreadPool* pool) {
+    return pool == nullptr ? 1 : 4 * pool->GetThreadCount();
+}
+
+
+//Все вхождения в тексте из байтов или кодов
+template <typename Text, typename T>
+std::vector<size_t> FindAllChunked(const Text& str, const BasicPatternSpectrum<T>& spectrum,
+                                   ThreadPool* pool) {
+    INSTRUMENT_SCOPE("SubstringMatching::FindChunked", T, str.size());
+    std::vector<size_t> result;
+    //нужны все вхождения, так что все куски считаются одной волной
+    ForEachBlock(str, spectrum, pool, str.size() + 1, [&result](const std::vector<size_t>& positions) {
+        result.insert(result.end(), begin(positions), end(positions));
+        return true;
+    });
+    return result;
+}
+}
+
+template <typename T>
+std::vector<size_t> FindChunked(std::string_view str, const BasicPatternSpectrum<T>& spectrum,
+                                ThreadPool* pool) {
+    return FindAllChunked(str, spectrum, pool);
+}
+
+template <typename T>
+std::vector<size_t> FindChunked(const std::vector<uint32_t>& codes,
+                                const BasicPatternSpectrum<T>& spectrum, ThreadPool* pool) {
+    return FindAllChunked(codes, spectrum, pool);
+}
+
+void VisitChunked(std::string_view str, const PatternSpectrum& spectrum,
+                  const MatchVisitor& visitor, ThreadPool* pool) {
+    INSTRUMENT_SCOPE("SubstringMatching::VisitChunked", PatternSpectrum::Complex, str.size());
+    ForEachBlock(str, spectrum, pool, GetWaveSize(pool), [&visitor](const std::vector<size_t>& positions) {
+        for (size_t position : positions) {
+            if (!visitor(position)) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+size_t CountChunked(std::string_view str, const PatternSpectrum& spectrum, ThreadPool* pool) {
+    size_t result = 0;
+    ForEachBlock(str, spectrum, pool, GetWaveSize(pool), [&result](const std::vector<size_t>& positions) {
+        result += positions.size();
+        return true;
+    });
+    return result;
 }
+
+std::optional<size_t> FindFirstChunked(std::string_view str, const PatternSpectrum& spectrum,
+                                       ThreadPool* pool) {
+    std::vector<size_t> result = FindFirstKChunked(str, spectrum, 1, pool);
+    if (result.empty()) {
+        return std::nullopt;
+    }
+    return result[0];
+}
+
+std::vector<size_t> FindFirstKChunked(std::string_view str, const PatternSpectrum& spectrum,
+                                      size_t k, ThreadPool* pool) {
+    std::vector<size_t> result;
+    if (k == 0) {
+        return result;
+    }
+    ForEachBlock(str, spectrum, pool, GetWaveSize(pool), [&result, k](const std::vector<size_t>& positions) {
+        size_t taken = std::min(k - result.size(), positions.size());
+        result.insert(result.end(), begin(positions), begin(positions) + taken);
+        return result.size() < k;
+    });
+    return result;
+}
+
+std::vector<bool> MatchBitmapChunked(std::string_view str, const PatternSpectrum& spectrum,
+                                     ThreadPool* pool) {
+    if (str.size() < spectrum.GetPatternSize()) {
+        return {};
+    }
+    std::vector<bool> result(str.size() - spectrum.GetPatternSize() + 1);
+    ForEachBlock(str, spectrum, pool, GetWaveSize(pool), [&result](const std::vector<size_t>& positions) {
+        for (size_t position : positions) {
+            result[position] = true;
+        }
+        return true;
+    });
+    return result;
+}
+
+std::vector<size_t> FindSubstringsChunked(std::string_view str, std::string_view pattern,
+                                          ThreadPool* pool) {
+    if (pattern.empty() || pattern.size() > str.size()) {
+        return {};
+    }
+    //короткому тексту хватит одного куска
+    PatternSpectrum spectrum(pattern, std::nullopt, std::min(kBlockLength, str.size()));
+    return FindChunked(str, spectrum, pool);
+}
+
+std::vector<size_t> FindMatchesChunked(std::string_view str, std::string_view pattern,
+                                       ThreadPool* pool) {
+    if (pattern.empty() || pattern.size() > str.size()) {
+        return {};
+    }
+    PatternSpectrum spectrum(pattern, '?', std::min(kBlockLength, str.size()));
+    return FindChunked(str, spectrum, pool);
+}
+
+std::vector<std::pair<size_t, size_t>> FindMatchesBatch(
+    const std::vector<std::string_view>& documents, std::string_view pattern,
+    std::optional<char> wildcard, ThreadPool* pool, size_t batch_length) {
+    std::vector<std::pair<size_t, size_t>> result;
+    if (pattern.empty()) {
+        return result;
+    }
+    INSTRUMENT_SCOPE("SubstringMatching::FindMatchesBatch", PatternSpectrum::Complex,
+                     documents.size());
+    PatternSpectrum spectrum(pattern, wildcard);
+
+    std::string batch;
+    //starts[i] - начало документа first + i в batch
+    std::vector<size_t> starts;
+    size_t first = 0;
+    auto search = [&](size_t end) {
+        starts.push_back(batch.size());
+        size_t document = 0;
+        for (size_t position : FindChunked(batch, spectrum, pool)) {
+            while (starts[document + 1] <= position) {
+                ++document;
+            }
+            if (position + pattern.size() <= starts[document + 1]) {
+                result.emplace_back(first + document, position - starts[document]);
+            }
+        }
+        batch.clear();
+        starts.clear();
+        first = end;
+    };
+
+    for (size_t document = 0; document < documents.size(); ++document) {
+        starts.push_back(batch.size());
+        batch.append(documents[document]);
+        if (batch.size() >= batch_length) {
+            search(document + 1);
+        }
+    }
+    if (!starts.empty()) {
+        search(documents.size());
+    }
+    return result;
+}
+
+StreamMatcher::StreamMatcher(std::string_view pattern, std::optional<char> wildcard,
+                             size_t block_length)
+    : spectrum_(pattern, wildcard, block_length) {
+}
+
+std::vector<size_t> StreamMatcher::Append(std::string_view data) {
+    INSTRUMENT_SCOPE("SubstringMatching::StreamMatcher::Append", PatternSpectrum::Complex,
+                     data.size());
+    std::vector<size_t> result;
+    pending_.append(data);
+    //полный кусок дает окончательный ответ для GetStep() позиций с cursor_,
+    //просмотренные байты отбрасываются один раз после всех кусков
+    while (pending_.size() - cursor_ >= spectrum_.GetBlockLength()) {
+        Advance(spectrum_.GetStep(), result);
+    }
+    Compact();
+    return result;
+}
+
+std::vector<size_t> StreamMatcher::Flush() {
+    std::vector<size_t> result;
+    if (pending_.size() - cursor_ >= spectrum_.GetPatternSize()) {
+        Advance(pending_.size() - cursor_ - spectrum_.GetPatternSize() + 1, result);
+    }
+    Compact();
+    return result;
+}
+
+void StreamMatcher::Advance(size_t count, std::vector<size_t>& result) {
+    for (size_t position : spectrum_.FindInBlock(pending_, cursor_, buffer_)) {
+        if (position < cursor_ + count) {
+            result.push_back(offset_ + position);
+        }
+    }
+    cursor_ += count;
+}
+
+void StreamMatcher::Compact() {
+    pending_.erase(0, cursor_);
+    offset_ += cursor_;
+    cursor_ = 0;
+}
+
+std::vector<std::pair<size_t, size_t>> FindMatches2D(const std::vector<std::string>& image,
+                                                     const std::vector<std::string>& pattern,
+                                                     char wildcard) {
+    //прямоугольность проверяем до сравнения размеров по первым строкам,
+    //иначе рваный ввод мог бы молча дать пустой ответ
+    auto is_rectangle = [](const std::vector<std::string>& rows) {
+        return std::all_of(begin(rows), end(rows), [&rows](const std::string& row) {
+            return row.size() == rows[0].size();
+        });
+    };
+    if (!is_rectangle(image) || !is_rectangle(pattern)) {
+        std::ostringstream os;
+        os << "Exception thrown in FindMatches2D, rows of image and pattern"
+              " must have equal length\n";
+        throw std::runtime_error(os.str());
+    }
+    if (image.empty() || pattern.empty() || pattern.size() > image.size() ||
+        pattern[0].empty() || pattern[0].size() > image[0].size()) {
+        return {};
+    }
+
+    INSTRUMENT_SCOPE("SubstringMatching::FindMatches2D", std::complex<long double>,
+                     image.size() * image[0].size());
+    size_t height = image.size(), width = image[0].size();
+    size_t pattern_height = pattern.size(), pattern_width = pattern[0].size();
+
+    //то же, что и в FindMatchesFFT: в точке (r, c) зануляется
+    //sum p * (p - t)^2 = sum p^3 - 2 * sum p^2 * t + sum p * t^2,
+    //где суммы идут по клеткам шаблона, а t взято со сдвигом (r, c).
+    //корреляции считаем двумерным ффт, сдвиги не заворачиваются по кругу,
+    //если размеры не меньше размеров изображения
+    size_t rows = 1, cols = 1;
+    while (rows < height) {
+        rows *= 2;
+    }
+    while (cols < width) {
+        cols *= 2;
+    }
+
+    //символы кодируем как unsigned char + 1, чтобы '\0' не путался с джокером,
+    //а джокер кодируем нулем
+    using Complex = std::complex<long double>;
+    std::vector<Complex> str_(rows * cols), str_squared(rows * cols);
+    std::vector<Complex> pattern_(rows * cols), pattern_squared(rows * cols);
+    for (size_t row = 0; row < height; ++row) {
+        for (size_t col = 0; col < width; ++col) {
+            long double value = static_cast<unsigned char>(image[row][col]) + 1;
+            str_[row * cols + col] = value;
+            str_squared[row * cols + col] = value * value;
+        }
+    }
+    long double cube_sum_pattern = 0;
+    for (size_t row = 0; row < pattern_height; ++row) {
+        for (size_t col = 0; col < pattern_width; ++col) {
+            char symbol = pattern[row][col];
+            long double value = symbol == wildcard ? 0 : static_cast<unsigned char>(symbol) + 1;
+            pattern_[row * cols + col] = value;
+            pattern_squared[row * cols + col] = value * value;
+            cube_sum_pattern += value * value * value;
+        }
+    }
+
+    //оценка погрешности считается по значениям, а не по спектрам
+    bool check_accuracy = Accuracy::IsEnabled();
+    double error_bound = 0;
+    if (check_accuracy) {
+        error_bound =
+            Accuracy::ConvolutionErrorBound(str_squared, pattern_, rows * cols) +
+            2 * Accuracy::ConvolutionErrorBound(str_, pattern_squared, rows * cols);
+    }
+
+    str_ = FFT::FastFourierTransform2D(str_, rows, cols);
+    str_squared = FFT::FastFourierTransform2D(str_squared, rows, cols);
+    pattern_ = FFT::FastFourierTransform2D(pattern_, rows, cols);
+    pattern_squared = FFT::FastFourierTransform2D(pattern_squared, rows, cols);
+
+    //для вещественного шаблона корреляция - это произведение
+    //спектра изображения на сопряженный спектр шаблона
+    std::vector<Complex> correlation(rows * cols);
+    for (size_t i = 0; i < correlation.size(); ++i) {
+        correlation[i] = str_squared[i] * std::conj(pattern_[i]) -
+                         Complex(2) * str_[i] * std::conj(pattern_squared[i]);
+    }
+    correlation = FFT::FastInverseFourierTransform2D(correlation, rows, cols);
+
+    std::vector<std::pair<size_t, size_t>> result;
+    double max_distance = 0;
+    for (size_t row = 0; row + pattern_height <= height; ++row) {
+        for (size_t col = 0; col + pattern_width <= width; ++col) {
+            long double value = cube_sum_pattern + std::real(correlation[row * cols + col]);
+            if (check_accuracy) {
+                max_distance = std::max(max_distance,
+                                        double(std::abs(value - std::round(value))));
+            }
+            if (std::round(value) == 0) {
+                result.emplace_back(row, col);
+            }
+        }
+    }
+    if (check_accuracy) {
+        Accuracy::Record("SubstringMatching::FindMatches2D", height * width,
+                         max_distance, error_bound);
+    }
+
+    return result;
+}
+
+template class BasicPatternSpectrum<std::complex<float>>;
+template class BasicPatternSpectrum<std::complex<double>>;
+template class BasicPatternSpectrum<std::complex<long double>>;
+
+template std::vector<size_t> FindChunked(
+    std::string_view str, const BasicPatternSpectrum<std::complex<float>>& spectrum,
+    ThreadPool* pool);
+template std::vector<size_t> FindChunked(
+    std::string_view str, const BasicPatternSpectrum<std::complex<double>>& spectrum,
+    ThreadPool* pool);
+template std::vector<size_t> FindChunked(
+    std::string_view str, const BasicPatternSpectrum<std::complex<long double>>& spectrum,
+    ThreadPool* pool);
+
+template std::vector<size_t> FindChunked(
+    const std::vector<uint32_t>& codes, const BasicPatternSpectrum<std::complex<float>>& spectrum,
+    ThreadPool* pool);
+template std::vector<size_t> FindChunked(
+    const std::vector<uint32_t>& codes, const BasicPatternSpectrum<std::complex<double>>& spectrum,
+    ThreadPool* pool);
+template std::vector<size_t> FindChunked(
+    const std::vector<uint32_t>& codes,
+    const BasicPatternSpectrum<std::complex<long double>>& spectrum, ThreadPool* pool);
 }
\ No newline at end of file
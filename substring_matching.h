@@ -7,8 +7,16 @@
 #include <algorithm>
 #include <iomanip>
 #include <complex>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <numeric>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "fft.h"
+#include "thread_pool.h"
 
 // Задачи, решаемые с помощью умножения многочленов
 // Если вы напишете решение, работающее для произольных строк над ascii кодировкой - укажете это и
@@ -25,9 +33,187 @@ std::vector<size_t> FindMatches(const std::string& str, const std::string& patte
 //С помощью ффт
 std::vector<size_t> FindMatchesFFT(const std::string& str, const std::string& pattern);
 
+//Длина куска текста по умолчанию для поиска по кускам: рабочий массив
+//и ядро вместе занимают 512 Кб и помещаются в кэш второго уровня
+const size_t kBlockLength = size_t(1) << 13;
+
+//Длина куска для шаблона длины pattern_size: степень двойки,
+//не меньшая block_length и 2 * pattern_size
+size_t RoundBlockLength(size_t pattern_size, size_t block_length);
+
+//Спектр шаблона для поиска по кускам текста. В позиции i зануляется
+//sum p * (p - t)^2 = sum p^3 - 2 * sum p^2 * t + sum p * t^2, где p - коды шаблона
+//(0 для джокера), t - коды текста (unsigned char + 1 для байтов или коды алфавита).
+//Обе корреляции считаются одним комплексным ффт: текст кодируется как t + i * t^2,
+//а ядро - как -2 * p^2 - i * p, тогда вещественная часть свертки и есть нужная
+//сумма без sum p^3. Ядро считается один раз и общее для всех кусков и потоков.
+//T - тип ффт, std::complex<float>, <double> или <long double>: байтам в общем
+//случае нужен long double, а маленьким алфавитам хватает и меньшей точности
+template <typename T>
+class BasicPatternSpectrum {
+ public:
+  using Complex = T;
+
+  //Без wildcard шаблон ищется как подстрока. Длина куска - степень двойки,
+  //не меньшая block_length и 2 * pattern.size()
+  BasicPatternSpectrum(std::string_view pattern, std::optional<char> wildcard,
+                       size_t block_length = kBlockLength);
+
+  //Шаблон из кодов алфавита, код 0 - джокер
+  explicit BasicPatternSpectrum(const std::vector<uint32_t>& pattern,
+                                size_t block_length = kBlockLength);
+
+  size_t GetPatternSize() const {
+      return pattern_size_;
+  }
+
+  size_t GetBlockLength() const {
+      return plan_.GetDegree();
+  }
+
+  //Соседние куски сдвинуты на GetStep() и перекрываются на pattern.size() - 1
+  size_t GetStep() const {
+      return plan_.GetDegree() - pattern_size_ + 1;
+  }
+
+  //Вхождения в text, начинающиеся в [begin, begin + GetStep()), по возрастанию,
+  //buffer - рабочий массив, его можно переиспользовать между вызовами
+  std::vector<size_t> FindInBlock(std::string_view text, size_t begin,
+                                  std::vector<Complex>& buffer) const;
+
+  //То же для текста из кодов алфавита
+  std::vector<size_t> FindInBlock(const std::vector<uint32_t>& text, size_t begin,
+                                  std::vector<Complex>& buffer) const;
+
+ private:
+  //codes[j] - код j-го символа шаблона
+  template <typename Codes>
+  void SetPattern(const Codes& codes);
+
+  template <typename Text>
+  std::vector<size_t> FindInCodes(const Text& text, size_t begin,
+                                  std::vector<Complex>& buffer) const;
+
+  size_t pattern_size_;
+  long double cube_sum_;
+  //развернутое ядро во временной области, нужно только для оценки погрешности
+  std::vector<Complex> weights_;
+  std::vector<Complex> kernel_;
+  FFT::Plan<Complex> plan_;
+};
+
+//Спектр для байтов в точности, которой хватает любому тексту
+using PatternSpectrum = BasicPatternSpectrum<std::complex<long double>>;
+
+//Поиск по кускам с общим спектром шаблона, куски обрабатываются в pool, если он задан.
+//Память - O(длины куска) на поток вместо O(длины текста). Текст - байты или коды
+//алфавита, как и шаблон спектра
+template <typename T>
+std::vector<size_t> FindChunked(std::string_view str, const BasicPatternSpectrum<T>& spectrum,
+                                ThreadPool* pool = nullptr);
+
+template <typename T>
+std::vector<size_t> FindChunked(const std::vector<uint32_t>& codes,
+                                const BasicPatternSpectrum<T>& spectrum,
+                                ThreadPool* pool = nullptr);
+
+//Обработчик вхождений: получает позиции по возрастанию, false - остановить поиск
+using MatchVisitor = std::function<bool(size_t)>;
+
+//Режимы без вектора всех вхождений. Куски считаются волнами по несколько кусков
+//на поток пула, и как только ответ известен, следующие волны не начинаются
+void VisitChunked(std::string_view str, const PatternSpectrum& spectrum,
+                  const MatchVisitor& visitor, ThreadPool* pool = nullptr);
+
+size_t CountChunked(std::string_view str, const PatternSpectrum& spectrum,
+                    ThreadPool* pool = nullptr);
+
+//Первое вхождение, std::nullopt, если вхождений нет
+std::optional<size_t> FindFirstChunked(std::string_view str, const PatternSpectrum& spectrum,
+                                       ThreadPool* pool = nullptr);
+
+//Не больше k первых вхождений
+std::vector<size_t> FindFirstKChunked(std::string_view str, const PatternSpectrum& spectrum,
+                                      size_t k, ThreadPool* pool = nullptr);
+
+//result[i] - начинается ли вхождение в позиции i, размер str.size() - pattern.size() + 1
+std::vector<bool> MatchBitmapChunked(std::string_view str, const PatternSpectrum& spectrum,
+                                     ThreadPool* pool = nullptr);
+
+//То же, что FindSubstringsFFT и FindMatchesFFT, но по кускам
+std::vector<size_t> FindSubstringsChunked(std::string_view str, std::string_view pattern,
+                                          ThreadPool* pool = nullptr);
+std::vector<size_t> FindMatchesChunked(std::string_view str, std::string_view pattern,
+                                       ThreadPool* pool = nullptr);
+
+//Длина склейки документов, которая ищется за один вызов FindChunked
+const size_t kBatchLength = size_t(1) << 20;
+
+//Поиск во множестве коротких документов: документы склеиваются подряд в тексты
+//длины около kBatchLength, которые ищутся по кускам с общим спектром шаблона,
+//а вхождения, задевающие два документа, отбрасываются. Возвращает пары
+//(номер документа, смещение в документе) в порядке документов и смещений.
+//batch_length меньше kBatchLength нужен тестам, чтобы склеек было несколько
+std::vector<std::pair<size_t, size_t>> FindMatchesBatch(
+    const std::vector<std::string_view>& documents, std::string_view pattern,
+    std::optional<char> wildcard = '?', ThreadPool* pool = nullptr,
+    size_t batch_length = kBatchLength);
+
+//Поиск в потоке текста, который только дописывается. Между вызовами хранит меньше
+//длины куска байт: последние pattern.size() - 1 байт уже просмотренного текста
+//как контекст и еще не просмотренный хвост. Целые куски ищутся сразу при добавлении,
+//короткие добавления копятся до заполнения куска, поэтому работа на каждое
+//добавление линейна по его длине и не зависит от длины уже прочитанного потока
+class StreamMatcher {
+ public:
+  StreamMatcher(std::string_view pattern, std::optional<char> wildcard,
+                size_t block_length = kBlockLength);
+
+  //Добавляет data в конец потока и возвращает новые вхождения,
+  //смещения - от начала потока
+  std::vector<size_t> Append(std::string_view data);
+
+  //Ищет в накопленном хвосте, не дожидаясь заполнения куска, после вызова
+  //известны все вхождения, целиком лежащие в уже добавленном тексте
+  std::vector<size_t> Flush();
+
+  //Сколько байт добавлено с начала потока
+  size_t GetSize() const {
+      return offset_ + pending_.size();
+  }
+
+ private:
+  //Ищет вхождения, начинающиеся в count байтах pending_ с позиции cursor_,
+  //и сдвигает cursor_ за них
+  void Advance(size_t count, std::vector<size_t>& result);
+
+  //Отбрасывает просмотренные байты перед cursor_ одним сдвигом
+  void Compact();
+
+  PatternSpectrum spectrum_;
+  //текст потока с позиции offset_, вхождения, начинающиеся раньше offset_ + cursor_,
+  //уже найдены
+  std::string pending_;
+  size_t offset_ = 0;
+  size_t cursor_ = 0;
+  std::vector<PatternSpectrum::Complex> buffer_;
+};
+
+//Двумерный поиск шаблона с джокерами wildcard в изображении с помощью двумерного ффт,
+//изображение и шаблон - прямоугольные (иначе бросает runtime_error), возвращает пары (строка, столбец)
+//левых верхних углов всех вхождений в порядке обхода по строкам
+std::vector<std::pair<size_t, size_t>> FindMatches2D(const std::vector<std::string>& image,
+                                                     const std::vector<std::string>& pattern,
+                                                     char wildcard = '?');
+
 //Тесты
 void TestSubstrings();
 void TestSubstringsHeyJude();
 void TestMatches();
 void TestMatchesHeyJude();
+void TestMatches2D();
+void TestChunked();
+void TestResultModes();
+void TestStreamMatcher();
+void TestBatch();
 } // namespace SubstringMatching
\ No newline at end of file
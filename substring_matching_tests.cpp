@@ -206,4 +206,235 @@ Hey, Jude)";
     ASSERT_EQUAL(Jude_positions, Jude_positions_fft);
     ASSERT_EQUAL(nah_positions, nah_positions_fft);
 }
-}
\ No newline at end of file
+
+void TestMatches2D() {
+    std::vector<std::string> image = {
+        "abcabc",
+        "bcabca",
+        "cabcab",
+        "abcabc",
+    };
+
+    using Positions = std::vector<std::pair<size_t, size_t>>;
+    Positions ab = {{0, 0}, {0, 3}, {1, 2}, {2, 1}, {2, 4}, {3, 0}, {3, 3}};
+    Positions a_over_b = {{0, 0}, {0, 3}, {1, 2}, {2, 1}, {2, 4}};
+    ASSERT(FindMatches2D(image, {"ab"}) == ab);
+    ASSERT(FindMatches2D(image, {"a?", "b?"}) == a_over_b);
+    ASSERT(FindMatches2D(image, {"*", "*"}, '*').size() == 3 * 6);
+    ASSERT(FindMatches2D(image, {"abcabca"}).empty());
+
+    //рваный ввод отвергается, даже если по первым строкам шаблон не помещается
+    for (const auto& ragged : std::vector<std::pair<std::vector<std::string>,
+                                                    std::vector<std::string>>>{
+             {{"ab", "abcabc"}, {"abc"}},
+             {image, {"abcabca", "a"}},
+             {{"a", "abc"}, {"a", "b", "c"}},
+         }) {
+        bool thrown = false;
+        try {
+            FindMatches2D(ragged.first, ragged.second);
+        } catch (std::runtime_error&) {
+            thrown = true;
+        }
+        ASSERT(thrown);
+    }
+
+    //сравним с перебором на случайном изображении
+    std::vector<std::string> big_image(40, std::string(70, 'a'));
+    unsigned seed = 17;
+    for (auto& row : big_image) {
+        for (auto& symbol : row) {
+            seed = seed * 1103515245 + 12345;
+            symbol = "ab"[(seed >> 16) % 2];
+        }
+    }
+    std::vector<std::string> pattern = {"a?b", "?ba"};
+    Positions brute_force;
+    for (size_t row = 0; row + pattern.size() <= big_image.size(); ++row) {
+        for (size_t col = 0; col + pattern[0].size() <= big_image[0].size(); ++col) {
+            bool found = true;
+            for (size_t i = 0; i < pattern.size(); ++i) {
+                for (size_t j = 0; j < pattern[0].size(); ++j) {
+                    if (pattern[i][j] != '?' && pattern[i][j] != big_image[row + i][col + j]) {
+                        found = false;
+                    }
+                }
+            }
+            if (found) {
+                brute_force.emplace_back(row, col);
+            }
+        }
+    }
+    ASSERT(!brute_force.empty());
+    ASSERT(FindMatches2D(big_image, pattern) == brute_force);
+}
+
+void TestChunked() {
+    //байты старше 127 и нулевой байт тоже ищутся правильно
+    std::string text;
+    for (size_t i = 0; i < 5000; ++i) {
+        const char alphabet[] = {'a', 'b', '\0', char(200)};
+        text.push_back(alphabet[(i * i + i / 3) % 4]);
+    }
+    std::vector<std::string> patterns = {"a", "ab", std::string("a\0", 2) + char(200),
+                                         "b?a?", "?????"};
+    ThreadPool pool(3);
+    for (const std::string& pattern : patterns) {
+        std::vector<size_t> expected = FindMatches(text, pattern);
+        ASSERT_EQUAL(FindMatchesChunked(text, pattern), expected);
+        ASSERT_EQUAL(FindMatchesChunked(text, pattern, &pool), expected);
+        ASSERT_EQUAL(FindSubstringsChunked(text, pattern, &pool), FindSubstrings(text, pattern));
+
+        //маленькие куски: вхождения на стыках не теряются и не повторяются
+        PatternSpectrum spectrum(pattern, '?', 16);
+        ASSERT_EQUAL(spectrum.GetBlockLength(), 16u);
+        ASSERT_EQUAL(FindChunked(text, spectrum, &pool), expected);
+    }
+
+    PatternSpectrum long_pattern(std::string(100, 'a'), std::nullopt, 16);
+    ASSERT_EQUAL(long_pattern.GetBlockLength(), 256u);
+    ASSERT_EQUAL(long_pattern.GetStep(), 157u);
+
+    ASSERT_EQUAL(FindMatchesChunked("abracadabra", "a?ra"), std::vector<size_t>({0, 7}));
+    ASSERT_EQUAL(FindSubstringsChunked("abra?abra", "a?a"), std::vector<size_t>({3}));
+    ASSERT(FindMatchesChunked("ab", "abc").empty());
+    ASSERT(FindSubstringsChunked("abc", "").empty());
+}
+
+void TestResultModes() {
+    std::string text;
+    for (size_t i = 0; i < 3000; ++i) {
+        text.push_back("abc"[(i * i + i / 5) % 3]);
+    }
+    const std::string pattern = "a?b";
+    std::vector<size_t> expected = FindMatches(text, pattern);
+    ASSERT(expected.size() > 10);
+
+    PatternSpectrum spectrum(pattern, '?', 64);
+    ThreadPool pool(2);
+    for (ThreadPool* current_pool : {static_cast<ThreadPool*>(nullptr), &pool}) {
+        ASSERT_EQUAL(CountChunked(text, spectrum, current_pool), expected.size());
+        ASSERT_EQUAL(*FindFirstChunked(text, spectrum, current_pool), expected[0]);
+        std::vector<size_t> first_k(begin(expected), begin(expected) + 10);
+        ASSERT_EQUAL(FindFirstKChunked(text, spectrum, 10, current_pool), first_k);
+        ASSERT_EQUAL(FindFirstKChunked(text, spectrum, text.size(), current_pool), expected);
+
+        std::vector<bool> bitmap = MatchBitmapChunked(text, spectrum, current_pool);
+        ASSERT_EQUAL(bitmap.size(), text.size() - pattern.size() + 1);
+        ASSERT_EQUAL(size_t(std::count(begin(bitmap), end(bitmap), true)), expected.size());
+        ASSERT(bitmap[expected.back()]);
+
+        //обработчик видит вхождения по порядку и останавливает поиск
+        std::vector<size_t> visited;
+        VisitChunked(text, spectrum, [&visited](size_t position) {
+            visited.push_back(position);
+            return visited.size() < 3;
+        }, current_pool);
+        ASSERT_EQUAL(visited, std::vector<size_t>(begin(expected), begin(expected) + 3));
+    }
+
+    PatternSpectrum missing("ccccc", std::nullopt, 64);
+    ASSERT(!FindFirstChunked(text, missing, &pool).has_value());
+    ASSERT_EQUAL(CountChunked(text, missing), 0u);
+    ASSERT(FindFirstKChunked(text, spectrum, 0).empty());
+    ASSERT(MatchBitmapChunked("ab", spectrum).empty());
+}
+
+void TestStreamMatcher() {
+    std::string text;
+    for (size_t i = 0; i < 4000; ++i) {
+        text.push_back("ab\ncd"[(i * i + i / 7) % 5]);
+    }
+
+    for (std::optional<char> wildcard : {std::optional<char>('?'), std::optional<char>()}) {
+        const std::string pattern = wildcard ? "a?\n" : "\nc";
+        std::vector<size_t> expected = wildcard ? FindMatches(text, pattern)
+                                                : FindSubstrings(text, pattern);
+        ASSERT(!expected.empty());
+
+        //добавления разной длины, в том числе длиннее куска, и редкие Flush
+        StreamMatcher matcher(pattern, wildcard, 64);
+        std::vector<size_t> found;
+        size_t position = 0;
+        for (size_t step = 0; position < text.size(); ++step) {
+            size_t length = std::min(text.size() - position, (step * 37) % 150);
+            for (size_t offset : matcher.Append(std::string_view(text).substr(position, length))) {
+                found.push_back(offset);
+            }
+            position += length;
+            if (step % 10 == 0) {
+                for (size_t offset : matcher.Flush()) {
+                    found.push_back(offset);
+                }
+            }
+        }
+        for (size_t offset : matcher.Flush()) {
+            found.push_back(offset);
+        }
+        ASSERT_EQUAL(matcher.GetSize(), text.size());
+        ASSERT_EQUAL(found, expected);
+
+        //весь текст одним добавлением во много кусков
+        StreamMatcher whole(pattern, wildcard, 64);
+        found = whole.Append(text);
+        for (size_t offset : whole.Flush()) {
+            found.push_back(offset);
+        }
+        ASSERT_EQUAL(found, expected);
+    }
+
+    StreamMatcher short_stream("abc", std::nullopt);
+    ASSERT(short_stream.Append("ab").empty());
+    ASSERT(short_stream.Flush().empty());
+    ASSERT(short_stream.Append("c").empty());
+    ASSERT_EQUAL(short_stream.Flush(), std::vector<size_t>({0}));
+    ASSERT(short_stream.Flush().empty());
+}
+
+void TestBatch() {
+    std::vector<std::string> storage;
+    for (size_t i = 0; i < 300; ++i) {
+        std::string document;
+        for (size_t j = 0; j < (i * 37) % 23; ++j) {
+            document.push_back("abc"[(i + j * j) % 3]);
+        }
+        storage.push_back(document);
+    }
+    std::vector<std::string_view> documents(begin(storage), end(storage));
+
+    ThreadPool pool(2);
+    for (const std::string pattern : {"a?c", "ab", "??????"}) {
+        std::vector<std::pair<size_t, size_t>> expected;
+        for (size_t i = 0; i < storage.size(); ++i) {
+            for (size_t offset : FindMatches(storage[i], pattern)) {
+                expected.emplace_back(i, offset);
+            }
+        }
+        ASSERT(!expected.empty());
+        ASSERT(FindMatchesBatch(documents, pattern) == expected);
+        ASSERT(FindMatchesBatch(documents, pattern, '?', &pool) == expected);
+        //короткие склейки: граница склеек попадает и внутрь, и на стыки документов,
+        //а длина 1 ищет каждый непустой документ отдельно
+        for (size_t batch_length : {1, 7, 64, 1000}) {
+            ASSERT(FindMatchesBatch(documents, pattern, '?', nullptr, batch_length) ==
+                   expected);
+            ASSERT(FindMatchesBatch(documents, pattern, '?', &pool, batch_length) ==
+                   expected);
+        }
+    }
+
+    //склейки ровно по 10 байт: документы 0-1 и 2-3 заканчиваются точно на границе,
+    //вхождения в конце склейки и в первом документе следующей склейки находятся,
+    //а номера документов после каждой склейки продолжаются с нужного
+    std::vector<std::string_view> exact = {"xxxab", "abcab", "cxabc", "abcxx", "ab", "c", "abc"};
+    std::vector<std::pair<size_t, size_t>> exact_expected = {{1, 0}, {2, 2}, {3, 0}, {6, 0}};
+    ASSERT(FindMatchesBatch(exact, "abc", std::nullopt, nullptr, 10) == exact_expected);
+    ASSERT(FindMatchesBatch(exact, "abc", std::nullopt, nullptr) == exact_expected);
+
+    //вхождение через границу документов не находится
+    std::vector<std::string_view> halves = {"xxab", "cxx", "abc"};
+    std::vector<std::pair<size_t, size_t>> expected = {{2, 0}};
+    ASSERT(FindMatchesBatch(halves, "abc", std::nullopt) == expected);
+    ASSERT(FindMatchesBatch({}, "abc").empty());
+}
+}
@@ -0,0 +1,94 @@
+#include "thread_pool.h"
+
+namespace {
+//номер потока пула, в котором выполняется код, для сторонних потоков - нет
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_index = 0;
+}
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    thread_count = std::max<size_t>(thread_count, 1);
+    for (size_t i = 0; i < thread_count; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back([this, i] { Run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::Execute(std::function<void()> task) {
+    size_t index = current_pool == this
+                   ? current_index
+                   : next_queue_++ % queues_.size();
+    {
+        //увеличиваем счетчик до постановки в очередь, чтобы он не ушел в минус,
+        //и под мьютексом, чтобы не потерять пробуждение
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        ++pending_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::TryPop(size_t index, std::function<void()>& task) {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    if (queues_[index]->tasks.empty()) {
+        return false;
+    }
+    task = std::move(queues_[index]->tasks.back());
+    queues_[index]->tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::TrySteal(size_t index, std::function<void()>& task) {
+    for (size_t shift = 1; shift < queues_.size(); ++shift) {
+        Queue& victim = *queues_[(index + shift) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Run(size_t index) {
+    current_pool = this;
+    current_index = index;
+
+    while (true) {
+        std::function<void()> task;
+        if (TryPop(index, task) || TrySteal(index, task)) {
+            --pending_;
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+        //при остановке сначала разбираем оставшиеся задачи
+        if (stop_ && pending_ == 0) {
+            return;
+        }
+    }
+}
+
+ThreadPool& GetDefaultThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Пул потоков с перехватом работы (work stealing): у каждого потока своя очередь,
+// свои задачи он берет с конца, а при пустой очереди забирает задачи из начала чужих
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Дожидается выполнения всех поставленных задач
+  ~ThreadPool();
+
+  size_t GetThreadCount() const {
+      return threads_.size();
+  }
+
+  // Ставит задачу в очередь, задача, поставленная из потока пула,
+  // попадает в очередь этого же потока
+  void Execute(std::function<void()> task);
+
+  // Ставит задачу в очередь и возвращает future с ее результатом
+  template <typename F>
+  std::future<std::invoke_result_t<F>> Submit(F func) {
+      using Result = std::invoke_result_t<F>;
+      //std::function требует копируемости, поэтому packaged_task держим через shared_ptr
+      auto task = std::make_shared<std::packaged_task<Result()>>(std::move(func));
+      std::future<Result> result = task->get_future();
+      Execute([task] { (*task)(); });
+      return result;
+  }
+
+  // Вызывает func(i) для всех i из [begin, end) и дожидается завершения,
+  // вызывающий поток тоже разбирает индексы, поэтому можно звать и из задач пула
+  template <typename F>
+  void ParallelFor(size_t begin, size_t end, F func) {
+      if (begin >= end) {
+          return;
+      }
+
+      struct State {
+        std::atomic<size_t> next;
+        std::atomic<size_t> done{0};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+      };
+      auto state = std::make_shared<State>();
+      state->next = begin;
+      const size_t total = end - begin;
+
+      auto work = [state, end, total, &func] {
+          size_t index;
+          while ((index = state->next++) < end) {
+              try {
+                  func(index);
+              } catch (...) {
+                  std::lock_guard<std::mutex> lock(state->mutex);
+                  state->error = std::current_exception();
+              }
+              if (++state->done == total) {
+                  std::lock_guard<std::mutex> lock(state->mutex);
+                  state->finished.notify_all();
+              }
+          }
+      };
+
+      size_t helpers = std::min(GetThreadCount(), total - 1);
+      for (size_t i = 0; i < helpers; ++i) {
+          Execute(work);
+      }
+      work();
+
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->finished.wait(lock, [&state, total] { return state->done == total; });
+      if (state->error) {
+          std::rethrow_exception(state->error);
+      }
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void Run(size_t index);
+
+  bool TryPop(size_t index, std::function<void()>& task);
+
+  bool TrySteal(size_t index, std::function<void()>& task);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<size_t> pending_{0};
+  std::atomic<size_t> next_queue_{0};
+  bool stop_ = false;
+};
+
+// Общий пул на все ядра машины
+ThreadPool& GetDefaultThreadPool();
+
+//Тесты
+namespace ThreadPoolTests {
+void SubmitAndSteal();
+void ParallelFor();
+} // namespace ThreadPoolTests
@@ -0,0 +1,59 @@
+#include "thread_pool.h"
+#include "test_runner.h"
+
+namespace ThreadPoolTests {
+void SubmitAndSteal() {
+    ThreadPool pool(4);
+
+    std::vector<std::future<size_t>> results;
+    for (size_t i = 0; i < 100; ++i) {
+        results.push_back(pool.Submit([i] { return i * i; }));
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQUAL(results[i].get(), i * i);
+    }
+
+    //задачи, поставленные из задачи пула, попадают в очередь потока
+    //и разбираются остальными потоками
+    std::atomic<size_t> counter{0};
+    pool.Submit([&pool, &counter] {
+        for (size_t i = 0; i < 50; ++i) {
+            pool.Execute([&counter] { ++counter; });
+        }
+    }).get();
+    while (counter != 50) {
+        std::this_thread::yield();
+    }
+}
+
+void ParallelFor() {
+    ThreadPool pool(3);
+
+    std::vector<size_t> values(1000);
+    pool.ParallelFor(0, values.size(), [&values](size_t i) {
+        values[i] = 2 * i;
+    });
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQUAL(values[i], 2 * i);
+    }
+
+    //вложенный ParallelFor из задачи пула не должен зависать
+    std::atomic<size_t> sum{0};
+    pool.ParallelFor(0, 4, [&pool, &sum](size_t) {
+        pool.ParallelFor(0, 10, [&sum](size_t j) { sum += j; });
+    });
+    ASSERT_EQUAL(sum.load(), 180u);
+
+    bool thrown = false;
+    try {
+        pool.ParallelFor(0, 10, [](size_t i) {
+            if (i == 7) {
+                throw std::runtime_error("error");
+            }
+        });
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT(thrown);
+}
+} // namespace ThreadPoolTests